@@ -0,0 +1,38 @@
+#!/bin/bash
+
+# Run a gravity test problem for each value of one runtime parameter at
+# a few resolutions, and report the error in the potential (and, if the
+# run was made with gravity.verbose > 1, the time of the last Poisson
+# solve) for each run.  This is run from a problem directory, e.g.
+#
+#   ../gravity_comparison.sh sphere gravity.gravity_type "PoissonGrav MultipoleGrav" "16 32 64" \
+#       gravity.max_multipole_order=0
+#
+# The arguments are the name used for the output files, the parameter
+# that is varied, its values, the numbers of zones per dimension, and
+# then any other runtime parameters to pass to every run.  The
+# executable can be set with EXEC (default ./Castro3d.gnu.ex).
+
+if [ $# -lt 4 ]; then
+    echo "usage: $0 name parameter \"values\" \"ncells\" [runtime parameters...]"
+    exit 1
+fi
+
+name=$1
+param=$2
+values=$3
+ncells=$4
+shift 4
+
+EXEC=${EXEC:-./Castro3d.gnu.ex}
+
+for ncell in ${ncells}; do
+    for value in ${values}; do
+        out=${name}_${value}_${ncell}.out
+        ${EXEC} inputs amr.n_cell=${ncell} ${ncell} ${ncell} amr.plot_file=${name}_plt_${value}_${ncell}_ \
+                ${param}=${value} "$@" &> ${out}
+        error=$(grep "Error" ${out} | awk '{print $3}')
+        solve=$(grep "Gravity MLMG solve" ${out} | tail -1 | sed -e 's/.*: //')
+        echo "ncell = ${ncell} ${param} = ${value} error = ${error}${solve:+ (${solve})}"
+    done
+done
@@ -16,7 +16,20 @@ void Castro::problem_post_init()
 {
     BL_ASSERT(level == 0);
 
-    gravity->multilevel_solve_for_new_phi(0, parent->finestLevel());
+    if (gravity->get_gravity_type() == "MultipoleGrav") {
+
+        // The multipole expansion fills in phi along with the gravity.
+
+        for (int lev = 0; lev <= parent->finestLevel(); lev++) {
+            MultiFab& grav_new = getLevel(lev).get_new_data(Gravity_Type);
+            gravity->get_new_grav_vector(lev, grav_new, getLevel(lev).state[State_Type].curTime());
+        }
+
+    } else {
+
+        gravity->multilevel_solve_for_new_phi(0, parent->finestLevel());
+
+    }
 
     const int norm_power = 2;
 
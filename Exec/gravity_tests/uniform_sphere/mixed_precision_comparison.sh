@@ -0,0 +1,7 @@
+#!/bin/bash
+
+# Compare the error in the potential and the time spent in the Poisson
+# solve between the double precision and mixed precision solvers.
+
+../gravity_comparison.sh sphere_mp gravity.mlmg_mixed_precision "0 1" "32 64 128" \
+    amr.max_grid_size=32 amr.checkpoint_files_output=0 gravity.verbose=2
@@ -0,0 +1,7 @@
+#!/bin/bash
+
+# Compare the error in the potential from MultipoleGrav against the
+# error from PoissonGrav at a few resolutions.
+
+../gravity_comparison.sh sphere gravity.gravity_type "PoissonGrav MultipoleGrav" "16 32 64" \
+    gravity.max_multipole_order=0 gravity.drdxfac=2
@@ -0,0 +1,225 @@
+#include <iomanip>
+#include <string>
+
+#include <Castro.H>
+#include <Castro_util.H>
+
+#include <prob_parameters.H>
+#include <problem_initialize_state_data.H>
+
+using namespace amrex;
+
+void Castro::problem_post_init()
+{
+#if AMREX_SPACEDIM != 3
+    amrex::Error("the hydro kernel benchmark requires DIM = 3");
+#else
+
+    // Run each of the hot CTU hydro kernels on a single synthetic box
+    // and report how fast it goes.  The kernels are called exactly as
+    // in construct_ctu_hydro_source(), but each is timed on its own.
+
+    const int ncell = problem::ncell;
+
+    const Box bx(IntVect(0), IntVect(ncell-1));
+
+    const Box& obx = amrex::grow(bx, 1);
+    const Box& qbx = amrex::grow(bx, NUM_GROW);
+    const Box& qbx3 = amrex::grow(bx, 3);
+
+    const Box& xbx = amrex::surroundingNodes(bx, 0);
+    const Box& ybx = amrex::surroundingNodes(bx, 1);
+    const Box& zbx = amrex::surroundingNodes(bx, 2);
+
+    const Box& gxbx = amrex::grow(xbx, 1);
+    const Box& gybx = amrex::grow(ybx, 1);
+    const Box& gzbx = amrex::grow(zbx, 1);
+
+    const Box& cxbx = amrex::grow(xbx, IntVect(0, 1, 1));
+    const Box& tyxbx = amrex::grow(ybx, IntVect(0, 0, 1));
+
+    GeometryData geomdata = geom.data();
+
+    // the synthetic conserved state
+
+    FArrayBox U(qbx, NUM_STATE);
+    auto U_arr = U.array();
+
+    amrex::ParallelFor(qbx,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        problem_initialize_state_data(i, j, k, U_arr, geomdata);
+    });
+
+    FArrayBox rho_inv(qbx3, 1);
+    auto rho_inv_arr = rho_inv.array();
+
+    amrex::ParallelFor(qbx3,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        rho_inv_arr(i,j,k) = 1.0_rt / U_arr(i,j,k,URHO);
+    });
+
+    // the sources are zero
+
+    FArrayBox old_src(qbx3, NSRC);
+    old_src.setVal<RunOn::Device>(0.0_rt);
+
+    FArrayBox src_q(qbx3, NQSRC);
+    src_q.setVal<RunOn::Device>(0.0_rt);
+
+    // work arrays
+
+    FArrayBox q(qbx, NQTHERM);
+    FArrayBox qaux(qbx, NQAUX);
+    FArrayBox shk(obx, 1);
+
+    FArrayBox qxm(obx, NQ), qxp(obx, NQ);
+    FArrayBox qym(obx, NQ), qyp(obx, NQ);
+    FArrayBox qzm(obx, NQ), qzp(obx, NQ);
+
+    FArrayBox qmyx(tyxbx, NQ), qpyx(tyxbx, NQ);
+
+    FArrayBox ftmp1(obx, NUM_STATE);
+    FArrayBox qgdnvtmp1(obx, NGDNV);
+
+    FArrayBox flux0(gxbx, NUM_STATE), flux1(gybx, NUM_STATE), flux2(gzbx, NUM_STATE);
+    FArrayBox qe0(gxbx, NGDNV), qe1(gybx, NGDNV), qe2(gzbx, NGDNV);
+
+    FArrayBox update(bx, NUM_STATE);
+    update.setVal<RunOn::Device>(0.0_rt);
+
+    auto q_arr = q.array();
+    auto qaux_arr = qaux.array();
+    auto shk_arr = shk.array();
+
+    const Real time = 0.0_rt;
+
+    // get the primitive state once so that we can pick a timestep
+
+    ctoprim(qbx, time, U.const_array(), q_arr, qaux_arr);
+    Gpu::synchronize();
+
+    const Real umax = amrex::max(q.maxabs<RunOn::Device>(QU),
+                                 q.maxabs<RunOn::Device>(QV),
+                                 q.maxabs<RunOn::Device>(QW));
+    const Real cmax = qaux.max<RunOn::Device>(QC);
+
+    const Real* dx = geom.CellSize();
+    const Real dt = problem::cfl * amrex::min(dx[0], dx[1], dx[2]) / (umax + cmax);
+
+    const Real hdt = 0.5_rt * dt;
+    const Real cdtdx = dt / dx[0] / 3.0_rt;
+
+    // fill all of the inputs that the later kernels need
+
+    shock(obx, q.const_array(), old_src.const_array(), shk_arr);
+
+    trace_ppm(obx, 0, U.const_array(), rho_inv.const_array(), q.const_array(), qaux.const_array(),
+              src_q.const_array(), qxm.array(), qxp.array(), bx, dt);
+    trace_ppm(obx, 1, U.const_array(), rho_inv.const_array(), q.const_array(), qaux.const_array(),
+              src_q.const_array(), qym.array(), qyp.array(), bx, dt);
+    trace_ppm(obx, 2, U.const_array(), rho_inv.const_array(), q.const_array(), qaux.const_array(),
+              src_q.const_array(), qzm.array(), qzp.array(), bx, dt);
+
+    cmpflx_plus_godunov(xbx, qxm.array(), qxp.array(), flux0.array(), qe0.array(),
+                        qaux.const_array(), shk.const_array(), 0, false);
+    cmpflx_plus_godunov(ybx, qym.array(), qyp.array(), flux1.array(), qe1.array(),
+                        qaux.const_array(), shk.const_array(), 1, false);
+    cmpflx_plus_godunov(zbx, qzm.array(), qzp.array(), flux2.array(), qe2.array(),
+                        qaux.const_array(), shk.const_array(), 2, false);
+
+    Gpu::synchronize();
+
+    amrex::Print() << std::endl;
+    amrex::Print() << "hydro kernel benchmark" << std::endl;
+    amrex::Print() << "  box size = " << ncell << "^3, NQ = " << NQ << ", NUM_STATE = " << NUM_STATE
+                   << ", repetitions = " << problem::nreps << std::endl;
+    amrex::Print() << std::endl;
+
+    amrex::Print() << std::setw(24) << std::left << "kernel"
+                   << std::setw(14) << std::right << "time (s)"
+                   << std::setw(14) << "zones / s"
+                   << std::setw(14) << "bytes / zone" << std::endl;
+
+    // time a kernel.  bytes is the size of all of the FAB data the
+    // kernel reads or writes, so bytes / zone is a measure of the
+    // memory traffic the kernel needs per zone of its box.
+
+    auto benchmark = [&] (const std::string& name, const Box& kbx, const Long bytes, auto&& kernel)
+    {
+        // warm up
+        kernel();
+        Gpu::synchronize();
+
+        const Real t0 = ParallelDescriptor::second();
+        for (int n = 0; n < problem::nreps; ++n) {
+            kernel();
+        }
+        Gpu::synchronize();
+        const Real elapsed = ParallelDescriptor::second() - t0;
+
+        const Real zones = static_cast<Real>(kbx.numPts()) * problem::nreps;
+
+        amrex::Print() << std::setw(24) << std::left << name
+                       << std::setw(14) << std::right << std::scientific << std::setprecision(4) << elapsed
+                       << std::setw(14) << zones / elapsed
+                       << std::setw(14) << std::fixed << std::setprecision(1)
+                       << static_cast<Real>(bytes) / static_cast<Real>(kbx.numPts()) << std::endl;
+    };
+
+    benchmark("ctoprim", qbx,
+              U.nBytes() + q.nBytes() + qaux.nBytes(),
+              [&] () {
+                  ctoprim(qbx, time, U.const_array(), q_arr, qaux_arr);
+              });
+
+    benchmark("shock", obx,
+              q.nBytes() + old_src.nBytes() + shk.nBytes(),
+              [&] () {
+                  shock(obx, q.const_array(), old_src.const_array(), shk_arr);
+              });
+
+    benchmark("trace_ppm", obx,
+              U.nBytes() + rho_inv.nBytes() + q.nBytes() + qaux.nBytes() + src_q.nBytes() +
+              qxm.nBytes() + qxp.nBytes(),
+              [&] () {
+                  trace_ppm(obx, 0, U.const_array(), rho_inv.const_array(), q.const_array(),
+                            qaux.const_array(), src_q.const_array(),
+                            qxm.array(), qxp.array(), bx, dt);
+              });
+
+    benchmark("cmpflx_plus_godunov", cxbx,
+              qxm.nBytes() + qxp.nBytes() + ftmp1.nBytes() + qgdnvtmp1.nBytes() +
+              qaux.nBytes() + shk.nBytes(),
+              [&] () {
+                  cmpflx_plus_godunov(cxbx, qxm.array(), qxp.array(), ftmp1.array(), qgdnvtmp1.array(),
+                                      qaux.const_array(), shk.const_array(), 0, false);
+              });
+
+    benchmark("trans_single", tyxbx,
+              qym.nBytes() + qyp.nBytes() + qmyx.nBytes() + qpyx.nBytes() + qaux.nBytes() +
+              ftmp1.nBytes() + qgdnvtmp1.nBytes(),
+              [&] () {
+                  trans_single(tyxbx, 0, 1,
+                               qym.const_array(), qmyx.array(),
+                               qyp.const_array(), qpyx.array(),
+                               qaux.const_array(),
+                               ftmp1.const_array(), qgdnvtmp1.const_array(),
+                               hdt, cdtdx);
+              });
+
+    benchmark("consup_hydro", bx,
+              update.nBytes() + flux0.nBytes() + flux1.nBytes() + flux2.nBytes() +
+              qe0.nBytes() + qe1.nBytes() + qe2.nBytes(),
+              [&] () {
+                  consup_hydro(bx, update.array(),
+                               flux0.array(), qe0.const_array(),
+                               flux1.array(), qe1.const_array(),
+                               flux2.array(), qe2.const_array(),
+                               dt);
+              });
+
+    amrex::Print() << std::endl;
+#endif
+}
@@ -56,6 +56,7 @@
 #include <problem_tagging.H>
 
 #include <ambient.H>
+#include <data_log_writer.H>
 #include <castro_limits.H>
 
 #include <riemann_constants.H>
@@ -83,6 +84,11 @@ params_t     Castro::params;
 
 Real         Castro::num_zones_advanced = 0.0;
 
+int          Castro::num_retries = 0;
+Long         Castro::retry_snapshot_bytes = 0;
+Long         Castro::retry_snapshot_peak_bytes = 0;
+Real         Castro::retry_snapshot_time = 0.0;
+
 Vector<std::string> Castro::source_names;
 
 Vector<AMRErrorTag> Castro::error_tags;
@@ -140,6 +146,9 @@ IntVect      Castro::no_tile_size(1024,1024,1024);
 int          Castro::hydro_tile_size_has_been_tuned = 0;
 Long         Castro::largest_box_from_hydro_tile_size_tuning = 0;
 
+// the state of the CPU hydro tile size autotuning on each level
+Vector<Castro::HydroTileTuning> Castro::hydro_tile_tuning;
+
 // this will be reset upon restart
 Real         Castro::previousCPUTimeUsed = 0.0;
 
@@ -191,10 +200,15 @@ Castro::variableCleanUp ()
 #endif
 
 #ifdef AMREX_PARTICLES
+  FlushParticleTimestamps();
   delete TracerPC;
   TracerPC = 0;
 #endif
 
+    // Make sure all of the diagnostics have been written.
+
+    data_log_writer::finalize();
+
     desc_lst.clear();
 
     // C++ cleaning
@@ -552,6 +566,8 @@ Castro::read_params ()
            amrex::FileOpenFailed("amr_diag.out");
        }
 
+       data_log_writer::initialize();
+
    }
 
     Vector<int> tilesize(AMREX_SPACEDIM);
@@ -852,6 +868,18 @@ Castro::initMFs()
       mass_fluxes[dir] = std::make_unique<MultiFab>(MultiFab(get_new_data(State_Type).boxArray(), dmap, 1, 0));
     }
 
+#ifdef MHD
+    // the electric field in direction dir lives on the edges that are
+    // cell-centered in dir and nodal in the other two directions
+
+    electric.resize(3);
+
+    for (int dir = 0; dir < 3; ++dir) {
+      electric[dir] = std::make_unique<MultiFab>(MultiFab(amrex::convert(grids, IntVect::TheNodeVector() - IntVect::TheDimensionVector(dir)),
+                                                          dmap, 1, 0));
+    }
+#endif
+
 #if (AMREX_SPACEDIM <= 2)
     if (!Geom().IsCartesian()) {
       P_radial.define(getEdgeBoxArray(0), dmap, 1, 0);
@@ -872,6 +900,13 @@ Castro::initMFs()
         flux_reg.define(grids, dmap, crse_ratio, level, NUM_STATE);
         flux_reg.setVal(0.0);
 
+#ifdef MHD
+        mag_flux_reg.define(grids, parent->boxArray(level-1),
+                            dmap, parent->DistributionMap(level-1),
+                            geom, parent->Geom(level-1), 1);
+        mag_flux_reg.reset();
+#endif
+
 #if (AMREX_SPACEDIM < 3)
         if (!Geom().IsCartesian()) {
             pres_reg.define(grids, dmap, crse_ratio, level, 1);
@@ -1138,7 +1173,9 @@ Castro::initData ()
       add_magnetic_e(Bx_new, By_new, Bz_new, S_new);
 
       //check divB
-      check_div_B(Bx_new, By_new, Bz_new, S_new);
+      if (check_div_B(Bx_new, By_new, Bz_new, S_new) != 0) {
+          amrex::Error("Error: initial data has divergence of B not zero");
+      }
 
 #endif
 
@@ -1547,56 +1584,90 @@ Castro::estTimeStep (int is_new)
 
     std::string limiter = "castro.max_dt";
 
-    // Start the hydro with the max_dt value, but divide by CFL
-    // to account for the fact that we multiply by it at the end.
-    // This ensures that if max_dt is more restrictive than the hydro
-    // criterion, we will get exactly max_dt for a timestep.
+    // Decide which constraints apply. The CFL, diffusion, and burning
+    // constraints are evaluated together by estdt_fused(), unless the
+    // hydro constraint needs its own estimator (MHD or radiation-hydro).
 
-    Real estdt_hydro = max_dt / cfl;
+    bool fused_cfl = do_hydro;
+    bool do_diffusion_dt = false;
+    bool do_burning_dt = false;
 
-    if (do_hydro)
-    {
+#ifdef MHD
+    fused_cfl = false;
+#endif
 
 #ifdef RADIATION
-        if (Radiation::rad_hydro_combined) {
+    if (Radiation::rad_hydro_combined) {
+        fused_cfl = false;
+    }
+#endif
 
-            Real lestdt_hydro = estdt_rad(is_new);
-            ParallelDescriptor::ReduceRealMin(lestdt_hydro);
-            estdt_hydro = amrex::min(estdt_hydro, lestdt_hydro) * cfl;
-            if (verbose) {
-                amrex::Print() << "...estimated hydro-limited timestep at level " << level << ": " << estdt_hydro << std::endl;
-            }
-        }
-        else
-        {
+#ifdef DIFFUSION
+    do_diffusion_dt = diffuse_temp;
+#endif
+
+#ifdef REACTIONS
+    do_burning_dt = do_react && (castro::dtnuc_e < 1.e199_rt || castro::dtnuc_X < 1.e199_rt);
 #endif
 
+    // The local minimum (and its location) of each constraint. These are
+    // all reduced over ranks with a single collective.
+
+    Array<ValLocPair<Real, IntVect>, num_dt_constraints> dt_min;
+    for (auto& dt : dt_min) {
+        dt = ValLocPair<Real, IntVect>{1.e200_rt, IntVect(AMREX_D_DECL(0,0,0))};
+    }
+
+    if (do_diffusion_dt || do_burning_dt) {
+        dt_min = estdt_fused(is_new, fused_cfl, do_diffusion_dt, do_burning_dt);
+    }
+    else if (fused_cfl) {
+        // With only the CFL constraint we don't need the full EOS.
+        dt_min[cfl_dt] = estdt_cfl(is_new);
+    }
+
+    if (do_hydro && !fused_cfl) {
+#ifdef RADIATION
+        if (Radiation::rad_hydro_combined) {
+            dt_min[cfl_dt].value = estdt_rad(is_new);
+        }
+#endif
 #ifdef MHD
-          auto hydro_dt = estdt_mhd(is_new);
-#else
-          auto hydro_dt = estdt_cfl(is_new);
+        dt_min[cfl_dt] = estdt_mhd(is_new);
 #endif
+    }
 
-          amrex::ParallelAllReduce::Min(hydro_dt, MPI_COMM_WORLD);
-          estdt_hydro = amrex::min(estdt_hydro, hydro_dt.value) * cfl;
-          if (verbose) {
-              amrex::Print() << "...estimated hydro-limited timestep at level " << level << ": " << estdt_hydro << std::endl;
-              std::string idx_str = "(i";
+    amrex::ParallelAllReduce::Min(dt_min.data(), num_dt_constraints, MPI_COMM_WORLD);
+
+    std::string idx_str = "(i";
 #if AMREX_SPACEDIM >= 2
-              idx_str += ",j";
+    idx_str += ",j";
 #endif
 #if AMREX_SPACEDIM == 3
-              idx_str += ",k";
+    idx_str += ",k";
 #endif
-              idx_str += ")";
+    idx_str += ")";
 
-              amrex::Print() << "...hydro-limited CFL timestep constrained at " << idx_str << " = " << hydro_dt.index << std::endl;
-          }
+    // Start the hydro with the max_dt value, but divide by CFL
+    // to account for the fact that we multiply by it at the end.
+    // This ensures that if max_dt is more restrictive than the hydro
+    // criterion, we will get exactly max_dt for a timestep.
+
+    Real estdt_hydro = max_dt / cfl;
 
+    if (do_hydro)
+    {
+        estdt_hydro = amrex::min(estdt_hydro, dt_min[cfl_dt].value) * cfl;
+
+        if (verbose) {
+            amrex::Print() << "...estimated hydro-limited timestep at level " << level << ": " << estdt_hydro << std::endl;
 #ifdef RADIATION
-        }
+            if (!Radiation::rad_hydro_combined)
 #endif
-
+            {
+                amrex::Print() << "...hydro-limited CFL timestep constrained at " << idx_str << " = " << dt_min[cfl_dt].index << std::endl;
+            }
+        }
 
         // Determine if this is more restrictive than the maximum timestep limiting
 
@@ -1614,25 +1685,13 @@ Castro::estTimeStep (int is_new)
 
     Real estdt_diffusion = max_dt / cfl;
 
-    if (diffuse_temp)
+    if (do_diffusion_dt)
     {
-        auto diffuse_dt = estdt_temp_diffusion(is_new);
-        ParallelAllReduce::Min(diffuse_dt, MPI_COMM_WORLD);
-        estdt_diffusion = amrex::min(estdt_diffusion, diffuse_dt.value) * cfl;
+        estdt_diffusion = amrex::min(estdt_diffusion, dt_min[diffusion_dt].value) * cfl;
 
         if (verbose) {
             amrex::Print() << "...estimated diffusion-limited timestep at level " << level << ": " << estdt_diffusion << std::endl;
-            std::string idx_str = "(i";
-#if AMREX_SPACEDIM >= 2
-            idx_str += ",j";
-#endif
-#if AMREX_SPACEDIM == 3
-            idx_str += ",k";
-#endif
-            idx_str += ")";
-
-            amrex::Print() << "...diffusion-limited timestep constrained at " << idx_str << " = " << diffuse_dt.index << std::endl;
-
+            amrex::Print() << "...diffusion-limited timestep constrained at " << idx_str << " = " << dt_min[diffusion_dt].index << std::endl;
         }
     }
 
@@ -1648,27 +1707,13 @@ Castro::estTimeStep (int is_new)
     // Dummy value to start with
     Real estdt_burn = max_dt;
 
-    if (do_react && (castro::dtnuc_e < 1.e199_rt || castro::dtnuc_X < 1.e199_rt)) {
-
-        // Compute burning-limited timestep.
-
-        auto burn_dt = estdt_burning(is_new);
+    if (do_burning_dt) {
 
-        ParallelAllReduce::Min(burn_dt, MPI_COMM_WORLD);
-        estdt_burn = amrex::min(estdt_burn, burn_dt.value);
+        estdt_burn = amrex::min(estdt_burn, dt_min[burning_dt].value);
 
         if (verbose && estdt_burn < max_dt) {
             amrex::Print() << "...estimated burning-limited timestep at level " << level << ": " << estdt_burn << std::endl;
-            std::string idx_str = "(i";
-#if AMREX_SPACEDIM >= 2
-            idx_str += ",j";
-#endif
-#if AMREX_SPACEDIM == 3
-            idx_str += ",k";
-#endif
-            idx_str += ")";
-
-            amrex::Print() << "...burning-limited timestep constrained at " << idx_str << " = " << burn_dt.index << std::endl;
+            amrex::Print() << "...burning-limited timestep constrained at " << idx_str << " = " << dt_min[burning_dt].index << std::endl;
         }
 
         // Determine if this is more restrictive than the hydro limiting
@@ -1993,6 +2038,25 @@ Castro::post_timestep (int iteration_local)
 #endif
                 S_new, state[State_Type].curTime(), S_new.nGrow());
 
+#ifdef MHD
+    // After the reflux and average down, the magnetic field should be
+    // divergence free on this level and all of the finer ones.
+
+    if (mhd_check_div_B && level < finest_level) {
+        for (int lev = level; lev <= finest_level; ++lev) {
+            Castro& mhd_lev = getLevel(lev);
+            int n_fail = mhd_lev.check_div_B(mhd_lev.get_new_data(Mag_Type_x),
+                                             mhd_lev.get_new_data(Mag_Type_y),
+                                             mhd_lev.get_new_data(Mag_Type_z),
+                                             mhd_lev.get_new_data(State_Type));
+            if (n_fail != 0) {
+                amrex::Error("Error: divergence of B not zero on level " + std::to_string(lev) +
+                             " after the coarse-fine synchronization");
+            }
+        }
+    }
+#endif
+
 
 #ifdef DO_PROBLEM_POST_TIMESTEP
 
@@ -2034,6 +2098,11 @@ Castro::post_timestep (int iteration_local)
 
         }
 
+        // Hand any diagnostics whose reductions have completed
+        // to the data log writer.
+
+        data_log_writer::poll();
+
         if (sum_int_test || sum_per_test) {
           sum_integrated_quantities();
         }
@@ -2444,6 +2513,11 @@ Castro::post_init (Real /*stop_time*/)
 
         }
 
+        // Hand any diagnostics whose reductions have completed
+        // to the data log writer.
+
+        data_log_writer::poll();
+
         if (sum_int_test || sum_per_test) {
           sum_integrated_quantities();
         }
@@ -2570,6 +2644,17 @@ Castro::FluxRegCrseInit() {
     }
 #endif
 
+#ifdef MHD
+    // The electric fields are already multiplied by dt.  The edge flux
+    // register works grid by grid, so this loop cannot be tiled.
+
+    for (MFIter mfi(*electric[0]); mfi.isValid(); ++mfi) {
+      fine_level.mag_flux_reg.CrseAdd(mfi,
+                                      {&(*electric[0])[mfi], &(*electric[1])[mfi], &(*electric[2])[mfi]},
+                                      1.0_rt);
+    }
+#endif
+
 }
 
 
@@ -2600,6 +2685,48 @@ Castro::FluxRegFineAdd() {
     }
 #endif
 
+#ifdef MHD
+    for (MFIter mfi(*electric[0]); mfi.isValid(); ++mfi) {
+      mag_flux_reg.FineAdd(mfi,
+                           {&(*electric[0])[mfi], &(*electric[1])[mfi], &(*electric[2])[mfi]},
+                           1.0_rt);
+    }
+#endif
+
+}
+
+namespace {
+
+    // Would adding the reflux flux correction F to the zone (i,j,k) give
+    // a mass fraction outside [0, 1]? We use a safety factor of
+    // AMREX_SPACEDIM since multiple fluxes touching the same zone could be
+    // conspiring in the same direction.
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    bool
+    reflux_gives_invalid_X (int i, int j, int k,
+                            Array4<Real const> const& U,
+                            Array4<Real const> const& V,
+                            Array4<Real const> const& F)
+    {
+        Real rho = U(i,j,k,URHO);
+        Real drhoV = F(i,j,k,URHO) / V(i,j,k);
+        Real rhoInvNew = 1.0_rt / (rho + drhoV);
+
+        for (int n = 0; n < NumSpec; ++n) {
+            Real rhoX = U(i,j,k,UFS+n);
+            Real drhoX = F(i,j,k,UFS+n) / V(i,j,k);
+            Real XNew = (rhoX + AMREX_SPACEDIM * drhoX) * rhoInvNew;
+
+            if (XNew < -castro::abundance_failure_tolerance ||
+                XNew > 1.0_rt + castro::abundance_failure_tolerance) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
 }
 
 // reflux() synchronizes fluxes between levels and has two modes of operation.
@@ -2672,134 +2799,127 @@ Castro::reflux (int crse_level, int fine_level, bool in_post_timestep)
 
         MultiFab& crse_state = crse_lev.get_new_data(State_Type);
 
-        // Get a version of this state with one ghost zone.
-
-        MultiFab expanded_crse_state(crse_state.boxArray(), crse_state.DistributionMap(), crse_state.nComp(), 1);
-
-        crse_lev.expand_state(expanded_crse_state, crse_lev.state[State_Type].curTime(), 1);
-
         // Clear out the data that's not on coarse-fine boundaries so that this register only
         // modifies the fluxes on coarse-fine interfaces.
 
         reg->ClearInternalBorders(crse_lev.geom);
 
-        // The reflux operation can cause a small or negative density (for the same reason this
-        // can happen during the level advance). We want to avoid this scenario because our
-        // only recourse will be a density reset, which is disruptive. So before we apply the reflux,
-        // we need to clean up the flux register to limit any fluxes that would do this.
-        // This is nonconservative, since we do not go back and retroactively apply any
-        // correction on the fine grid. (Of course, a density reset would also be nonconservative.)
-        // We assume that the amount of fluid material lost this way is small since refluxes
-        // causing a small density should only happen around ambient material.
+        if (reflux_limit_in_place) {
 
-        // The simplest way to do this is make a copy of the flux register to a MultiFab,
-        // then loop through the data and calculate what the reflux operation would be,
-        // limiting the flux if it would result in a negative density. Then we overwrite
-        // the flux register with the updated data. This is more straightforward than operating
-        // on the flux register data directly, and we will anyway need this copy of the flux
-        // data in MultiFab form later.
+            // Limit the flux corrections where they live, on the faces of the
+            // coarse-fine interface only (see limit_flux_register below).
 
-        // We also apply a similar check to ensure that 0 < X < 1 after the reflux.
+            crse_lev.limit_flux_register(*reg, update_sources_after_reflux || !in_post_timestep);
 
-        MultiFab temp_fluxes[AMREX_SPACEDIM];
+        } else {
 
-        for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+            // Get a version of this state with one ghost zone.
 
-            temp_fluxes[idir].define(crse_lev.fluxes[idir]->boxArray(),
-                                     crse_lev.fluxes[idir]->DistributionMap(),
-                                     crse_lev.fluxes[idir]->nComp(), crse_lev.fluxes[idir]->nGrow());
+            MultiFab expanded_crse_state(crse_state.boxArray(), crse_state.DistributionMap(), crse_state.nComp(), 1);
 
-            temp_fluxes[idir].setVal(0.0);
+            crse_lev.expand_state(expanded_crse_state, crse_lev.state[State_Type].curTime(), 1);
 
-            // Start with a MultiFab version of the flux register.
+            // The reflux operation can cause a small or negative density (for the same reason this
+            // can happen during the level advance). We want to avoid this scenario because our
+            // only recourse will be a density reset, which is disruptive. So before we apply the reflux,
+            // we need to clean up the flux register to limit any fluxes that would do this.
+            // This is nonconservative, since we do not go back and retroactively apply any
+            // correction on the fine grid. (Of course, a density reset would also be nonconservative.)
+            // We assume that the amount of fluid material lost this way is small since refluxes
+            // causing a small density should only happen around ambient material.
 
-            for (OrientationIter fi; fi.isValid(); ++fi) {
-                const FabSet& fs = (*reg)[fi()];
-                if (fi().coordDir() == idir) {
-                    fs.copyTo(temp_fluxes[idir], 0, 0, 0, temp_fluxes[idir].nComp());
-                }
-            }
+            // The simplest way to do this is make a copy of the flux register to a MultiFab,
+            // then loop through the data and calculate what the reflux operation would be,
+            // limiting the flux if it would result in a negative density. Then we overwrite
+            // the flux register with the updated data. This is more straightforward than operating
+            // on the flux register data directly, and we will anyway need this copy of the flux
+            // data in MultiFab form later.
 
-        }
+            // We also apply a similar check to ensure that 0 < X < 1 after the reflux.
 
-        // Now zero out any problematic flux corrections.
+            MultiFab temp_fluxes[AMREX_SPACEDIM];
 
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-        for (MFIter mfi(crse_state, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-            const Box& bx = mfi.tilebox();
+            for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
 
-            auto U = expanded_crse_state[mfi].array();
-            auto V = crse_lev.volume[mfi].array();
+                temp_fluxes[idir].define(crse_lev.fluxes[idir]->boxArray(),
+                                         crse_lev.fluxes[idir]->DistributionMap(),
+                                         crse_lev.fluxes[idir]->nComp(), crse_lev.fluxes[idir]->nGrow());
 
-            // Limit fluxes that would cause a small/negative density.
-            // Also check to see whether the flux would cause invalid X. We use a
-            // safety factor of AMREX_SPACEDIM since multiple fluxes touching the
-            // same zone could be conspiring in the same direction. If we do detect
-            // a case where X would be invalid, we set that flux to zero.
+                temp_fluxes[idir].setVal(0.0);
 
-            for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
-                const Box& nbx = amrex::surroundingNodes(bx, idir);
-                auto F = temp_fluxes[idir][mfi].array();
-#ifndef MHD
-                auto A = crse_lev.area[idir][mfi].array();
-                Real dt = parent->dtLevel(crse_level);
+                // Start with a MultiFab version of the flux register.
 
-                bool scale_by_dAdt = false;
-                crse_lev.limit_hydro_fluxes_on_small_dens(nbx, idir, U, V, F, A, dt, scale_by_dAdt);
-#endif
-                amrex::ParallelFor(nbx,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                {
-                    bool zero_fluxes = false;
+                for (OrientationIter fi; fi.isValid(); ++fi) {
+                    const FabSet& fs = (*reg)[fi()];
+                    if (fi().coordDir() == idir) {
+                        fs.copyTo(temp_fluxes[idir], 0, 0, 0, temp_fluxes[idir].nComp());
+                    }
+                }
 
-                    Real rho = U(i,j,k,URHO);
-                    Real drhoV = F(i,j,k,URHO) / V(i,j,k);
-                    Real rhoInvNew = 1.0_rt / (rho + drhoV);
+            }
 
-                    for (int n = 0; n < NumSpec; ++n) {
-                        Real rhoX = U(i,j,k,UFS+n);
-                        Real drhoX = F(i,j,k,UFS+n) / V(i,j,k);
-                        Real XNew = (rhoX + AMREX_SPACEDIM * drhoX) * rhoInvNew;
+            // Now zero out any problematic flux corrections.
 
-                        if (XNew < -castro::abundance_failure_tolerance ||
-                            XNew > 1.0_rt + castro::abundance_failure_tolerance) {
-                            zero_fluxes = true;
-                            break;
-                        }
-                    }
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            for (MFIter mfi(crse_state, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.tilebox();
+
+                auto U = expanded_crse_state[mfi].array();
+                auto V = crse_lev.volume[mfi].array();
 
-                    if (zero_fluxes) {
-                        for (int n = 0; n < NUM_STATE; ++n) {
-                            F(i,j,k,n) = 0.0;
+                // Limit fluxes that would cause a small/negative density.
+                // Also check to see whether the flux would cause invalid X. We use a
+                // safety factor of AMREX_SPACEDIM since multiple fluxes touching the
+                // same zone could be conspiring in the same direction. If we do detect
+                // a case where X would be invalid, we set that flux to zero.
+
+                for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+                    const Box& nbx = amrex::surroundingNodes(bx, idir);
+                    auto F = temp_fluxes[idir][mfi].array();
+#ifndef MHD
+                    auto A = crse_lev.area[idir][mfi].array();
+                    Real dt = parent->dtLevel(crse_level);
+
+                    bool scale_by_dAdt = false;
+                    crse_lev.limit_hydro_fluxes_on_small_dens(nbx, idir, U, V, F, A, dt, scale_by_dAdt);
+#endif
+                    amrex::ParallelFor(nbx,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    {
+                        if (reflux_gives_invalid_X(i, j, k, U, V, F)) {
+                            for (int n = 0; n < NUM_STATE; ++n) {
+                                F(i,j,k,n) = 0.0;
+                            }
                         }
-                    }
-                });
+                    });
+                }
             }
-        }
 
-        for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+            for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
 
-            // Update the flux register now that we may have modified some of the flux corrections.
+                // Update the flux register now that we may have modified some of the flux corrections.
 
-            for (OrientationIter fi; fi.isValid(); ++fi) {
-                if (fi().coordDir() == idir) {
-                    FabSet& fs = (*reg)[fi()];
-                    fs.copyFrom(temp_fluxes[idir], 0, 0, 0, temp_fluxes[idir].nComp());
+                for (OrientationIter fi; fi.isValid(); ++fi) {
+                    if (fi().coordDir() == idir) {
+                        FabSet& fs = (*reg)[fi()];
+                        fs.copyFrom(temp_fluxes[idir], 0, 0, 0, temp_fluxes[idir].nComp());
+                    }
                 }
-            }
 
-            // Update the coarse fluxes MultiFabs using the reflux data. This should only make
-            // a difference if we re-evaluate the source terms later.
+                // Update the coarse fluxes MultiFabs using the reflux data. This should only make
+                // a difference if we re-evaluate the source terms later.
 
-            if (update_sources_after_reflux || !in_post_timestep) {
+                if (update_sources_after_reflux || !in_post_timestep) {
 
-                MultiFab::Add(*crse_lev.fluxes[idir], temp_fluxes[idir], 0, 0, crse_lev.fluxes[idir]->nComp(), 0);
+                    MultiFab::Add(*crse_lev.fluxes[idir], temp_fluxes[idir], 0, 0, crse_lev.fluxes[idir]->nComp(), 0);
 
-                // The gravity and rotation source terms depend on the mass fluxes.
+                    // The gravity and rotation source terms depend on the mass fluxes.
+
+                    MultiFab::Add(*crse_lev.mass_fluxes[idir], temp_fluxes[idir], URHO, 0, 1, 0);
+                }
 
-                MultiFab::Add(*crse_lev.mass_fluxes[idir], temp_fluxes[idir], URHO, 0, 1, 0);
             }
 
         }
@@ -2824,6 +2944,20 @@ Castro::reflux (int crse_level, int fine_level, bool in_post_timestep)
 
         reg->setVal(0.0);
 
+#ifdef MHD
+        // Correct the coarse face-centered magnetic field next to the
+        // coarse-fine boundary with the curl of the difference between
+        // the time- and edge-averaged fine electric field and the coarse
+        // one.  Together with the average down of the faces covered by
+        // the fine level this keeps div B = 0 on the coarse level.
+
+        getLevel(lev).mag_flux_reg.Reflux({&crse_lev.get_new_data(Mag_Type_x),
+                                           &crse_lev.get_new_data(Mag_Type_y),
+                                           &crse_lev.get_new_data(Mag_Type_z)});
+
+        getLevel(lev).mag_flux_reg.reset();
+#endif
+
 #if (AMREX_SPACEDIM <= 2)
         if (!Geom().IsCartesian()) {
 
@@ -2981,23 +3115,25 @@ Castro::reflux (int crse_level, int fine_level, bool in_post_timestep)
             // Temporarily restore the last iteration's old data for the purposes of recalculating the corrector.
             // This is only necessary if we've done subcycles on that level.
 
+            Vector<std::unique_ptr<MultiFab>> original_old(num_state_type);
+
             if (use_retry && dt_advance_local < dt_amr && getLevel(lev).keep_prev_state) {
 
                 for (int k = 0; k < num_state_type; k++) {
 
-                    if (getLevel(lev).prev_state[k]->hasOldData()) {
+                    if (getLevel(lev).prev_state[k]) {
 
-                        // Use the new-time data as a temporary buffer. Ideally this would be done
-                        // as a pointer swap, but we cannot assume that the distribution mapping
-                        // is the same between the current state and the original state, due to
-                        // possible regrids that have occurred in between.
+                        // Hold the original old data in a temporary buffer (in the same arena as
+                        // the retry snapshot) while the last iteration's old data is in place.
 
                         MultiFab& old = getLevel(lev).get_old_data(k);
-                        MultiFab::Copy(getLevel(lev).prev_state[k]->newData(), old, 0, 0, old.nComp(), old.nGrow());
-                        MultiFab::Copy(old, getLevel(lev).prev_state[k]->oldData(), 0, 0, old.nComp(), old.nGrow());
+                        original_old[k] = std::make_unique<MultiFab>(old.boxArray(), old.DistributionMap(),
+                                                                     old.nComp(), old.nGrowVect(),
+                                                                     MFInfo().SetArena(getLevel(lev).prev_state[k]->arena()));
+                        MultiFab::Copy(*original_old[k], old, 0, 0, old.nComp(), old.nGrowVect());
+                        MultiFab::Copy(old, *getLevel(lev).prev_state[k], 0, 0, old.nComp(), old.nGrowVect());
 
                         getLevel(lev).state[k].setTimeLevel(time, dt_advance_local, 0.0);
-                        getLevel(lev).prev_state[k]->setTimeLevel(time, dt_amr, 0.0);
 
                     }
 
@@ -3018,15 +3154,14 @@ Castro::reflux (int crse_level, int fine_level, bool in_post_timestep)
 
                 for (int k = 0; k < num_state_type; k++) {
 
-                    if (getLevel(lev).prev_state[k]->hasOldData()) {
+                    if (original_old[k]) {
 
                         // Now retrieve the original old time data.
 
                         MultiFab& old = getLevel(lev).get_old_data(k);
-                        MultiFab::Copy(old, getLevel(lev).prev_state[k]->newData(), 0, 0, old.nComp(), old.nGrow());
+                        MultiFab::Copy(old, *original_old[k], 0, 0, old.nComp(), old.nGrowVect());
 
                         getLevel(lev).state[k].setTimeLevel(time, dt_amr, 0.0);
-                        getLevel(lev).prev_state[k]->setTimeLevel(time, dt_advance_local, 0.0);
 
                     }
 
@@ -3035,7 +3170,7 @@ Castro::reflux (int crse_level, int fine_level, bool in_post_timestep)
                 // Now deallocate the old data, it is no longer needed.
 
                 if (lev == 0 || lev > level) {
-                    amrex::FillNull(getLevel(lev).prev_state);
+                    getLevel(lev).clear_retry_snapshot();
                     getLevel(lev).keep_prev_state = false;
                 }
 
@@ -3065,6 +3200,98 @@ Castro::reflux (int crse_level, int fine_level, bool in_post_timestep)
     }
 }
 
+void
+Castro::limit_flux_register (FluxRegister& reg, bool update_fluxes)
+{
+    BL_PROFILE("Castro::limit_flux_register()");
+
+    // This is the same limiting that reflux() does on MultiFab copies of
+    // the whole level, but done on the flux register itself, so we only
+    // touch the faces of the coarse-fine interface. For each face we
+    // gather the state and volume of the two coarse zones on either side
+    // of it, limit the flux correction in place, and then (if needed) add
+    // it to the coarse fluxes. Faces on a non-periodic physical boundary
+    // do not change the state in the reflux, so the mass fraction check
+    // skips them.
+
+    const MultiFab& S_new = get_new_data(State_Type);
+    const Real dt = parent->dtLevel(level);
+    const Box valid_cells = geom.growPeriodicDomain(1);
+
+    for (OrientationIter fi; fi.isValid(); ++fi) {
+
+        const int idir = fi().coordDir();
+        FabSet& fs = reg[fi()];
+
+        // The zones on either side of each face of the register. The
+        // register boxes are one face thick, so converting them to cells
+        // gives an empty box, and we then add the zone on each side.
+
+        BoxArray cba = fs.boxArray();
+        cba.convert(IndexType::TheCellType());
+        cba.growLo(idir, 1);
+        cba.growHi(idir, 1);
+
+        MultiFab U(cba, fs.DistributionMap(), NUM_STATE, 0);
+        MultiFab V(cba, fs.DistributionMap(), 1, 0);
+
+        U.setVal(0.0);
+        U.ParallelCopy(S_new, 0, 0, NUM_STATE, 0, 0, geom.periodicity());
+        V.ParallelCopy(volume, 0, 0, 1, volume.nGrow(), 0, geom.periodicity());
+
+        // and the areas of the faces themselves
+
+        MultiFab A(fs.boxArray(), fs.DistributionMap(), 1, 0);
+        A.ParallelCopy(area[idir], 0, 0, 1, area[idir].nGrow(), 0, geom.periodicity());
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (FabSetIter fsi(fs); fsi.isValid(); ++fsi) {
+            const Box& nbx = fsi.validbox();
+
+            auto F = fs[fsi].array();
+            auto Ua = U.const_array(fsi);
+            auto Va = V.const_array(fsi);
+
+#ifndef MHD
+            auto Aa = A.const_array(fsi);
+
+            bool scale_by_dAdt = false;
+            limit_hydro_fluxes_on_small_dens(nbx, idir, Ua, Va, F, Aa, dt, scale_by_dAdt);
+#endif
+            amrex::ParallelFor(nbx,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                if (!valid_cells.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                    return;
+                }
+
+                if (reflux_gives_invalid_X(i, j, k, Ua, Va, F)) {
+                    for (int n = 0; n < NUM_STATE; ++n) {
+                        F(i,j,k,n) = 0.0;
+                    }
+                }
+            });
+        }
+
+        // Update the coarse fluxes MultiFabs using the reflux data.
+
+        if (update_fluxes) {
+
+            MultiFab reg_fluxes(fs.boxArray(), fs.DistributionMap(), NUM_STATE, 0);
+            fs.copyTo(reg_fluxes, 0, 0, 0, NUM_STATE);
+
+            fluxes[idir]->ParallelAdd(reg_fluxes, 0, 0, fluxes[idir]->nComp(), 0, 0);
+
+            // The gravity and rotation source terms depend on the mass fluxes.
+
+            mass_fluxes[idir]->ParallelAdd(reg_fluxes, URHO, 0, 1, 0, 0);
+        }
+
+    }
+}
+
 void
 Castro::avgDown ()
 {
@@ -3410,6 +3637,17 @@ Castro::avgDown (int state_indx)
     MultiFab&  S_crse   = get_new_data(state_indx);
     MultiFab&  S_fine   = fine_lev.get_new_data(state_indx);
 
+#ifdef MHD
+    // The magnetic field is face-centered, and we average it down
+    // over the coarse face area so that the coarse field has the
+    // same (zero) divergence as the fine field.
+
+    if (state_indx == Mag_Type_x || state_indx == Mag_Type_y || state_indx == Mag_Type_z) {
+        amrex::average_down_faces(S_fine, S_crse, fine_ratio, cgeom);
+        return;
+    }
+#endif
+
     amrex::average_down(S_fine, S_crse,
                          fgeom, cgeom,
                          0, S_fine.nComp(), fine_ratio);
@@ -3844,7 +4082,7 @@ Castro::add_magnetic_e( MultiFab& Bx,
 
 }
 
-void
+int
 Castro::check_div_B( MultiFab& Bx,
                      MultiFab& By,
                      MultiFab& Bz,
@@ -3900,13 +4138,11 @@ Castro::check_div_B( MultiFab& Bx,
   }
 
   ReduceTuple hv = reduce_data.value();
-  int init_fail_divB = amrex::get<0>(hv);
-
-  if (init_fail_divB != 0) {
-     amrex::Error("Error: initial data has divergence of B not zero");
-  }
+  int fail_divB = amrex::get<0>(hv);
 
+  ParallelDescriptor::ReduceIntSum(fail_divB);
 
+  return fail_divB;
 }
 #endif
 
@@ -4511,34 +4747,122 @@ Castro::clean_state(
 
 }
 
+namespace {
+
+    // Memory footprint of a MultiFab, including ghost zones,
+    // summed over all ranks.
+
+    Long
+    retry_snapshot_nbytes (const MultiFab& mf)
+    {
+        Long npts = 0;
+
+        const BoxArray& ba = mf.boxArray();
+
+        for (int i = 0; i < ba.size(); ++i) {
+            npts += amrex::grow(ba[i], mf.nGrowVect()).numPts();
+        }
+
+        return npts * mf.nComp() * static_cast<Long>(sizeof(Real));
+    }
+
+}
+
+bool
+Castro::retry_snapshot_needed (int k)
+{
+    // These state types only ever carry meaningful new-time data
+    // (see swap_state_time_levels), so their old data never needs
+    // to be restored at the end of the step.
+
+#ifdef REACTIONS
+    if (k == Reactions_Type) {
+        return false;
+    }
+
+#ifdef SIMPLIFIED_SDC
+    if (k == Simplified_SDC_React_Type) {
+        return false;
+    }
+#endif
+
+#ifdef TRUE_SDC
+    if (k == SDC_Source_Type) {
+        return false;
+    }
+#endif
+#endif
+
+    // Everything else is needed. This includes the sources and
+    // gravity: the first retried subcycle does not swap the time
+    // levels, but it recomputes them at the old time with the
+    // subcycle's dt, overwriting the old data of the full step.
+
+    amrex::ignore_unused(k);
+
+    return true;
+}
+
 void
 Castro::save_data_for_retry ()
 {
     BL_PROFILE("Castro::save_data_for_retry()");
 
+    const Real strt_time = ParallelDescriptor::second();
+
     for (int k = 0; k < num_state_type; k++) {
 
-        // We want to store the previous state in pinned memory
-        // if we're running on a GPU. This helps us alleviate
-        // pressure on the GPU memory, at the slight cost of
-        // lower bandwidth when we are saving/restoring the state.
-        // Since we're using operator= to copy the StateData,
-        // we'll use a trick where we temporarily change the
-        // the arena used by the main state and then immediately
-        // restore it.
+        if (prev_state[k] || !state[k].hasOldData() || !retry_snapshot_needed(k)) {
+            continue;
+        }
+
+        snapshot_old_data(k);
 
-        if (!prev_state[k]->hasOldData()) {
+    }
+
+    retry_snapshot_time += ParallelDescriptor::second() - strt_time;
+
+    if (verbose) {
+        amrex::Print() << "  Retry snapshot at level " << level << " now holds "
+                       << static_cast<Real>(retry_snapshot_bytes) / (1024.0 * 1024.0)
+                       << " MB (peak " << static_cast<Real>(retry_snapshot_peak_bytes) / (1024.0 * 1024.0)
+                       << " MB)" << std::endl;
+    }
+
+}
+
+void
+Castro::snapshot_old_data (int k)
+{
+    // We want to store the previous state in pinned memory
+    // if we're running on a GPU. This helps us alleviate
+    // pressure on the GPU memory, at the slight cost of
+    // lower bandwidth when we are saving/restoring the state.
+
+    const MultiFab& old = get_old_data(k);
 
 #ifdef AMREX_USE_GPU
-            Arena* old_arena = state[k].getArena();
-            state[k].setArena(The_Pinned_Arena());
-#endif
-            *prev_state[k] = state[k];
-#ifdef AMREX_USE_GPU
-            state[k].setArena(old_arena);
+    Arena* arena = The_Pinned_Arena();
+#else
+    Arena* arena = The_Arena();
 #endif
-        }
 
-    }
+    prev_state[k] = std::make_unique<MultiFab>(old.boxArray(), old.DistributionMap(),
+                                               old.nComp(), old.nGrowVect(),
+                                               MFInfo().SetArena(arena));
+    MultiFab::Copy(*prev_state[k], old, 0, 0, old.nComp(), old.nGrowVect());
+
+    retry_snapshot_bytes += retry_snapshot_nbytes(*prev_state[k]);
+    retry_snapshot_peak_bytes = std::max(retry_snapshot_peak_bytes, retry_snapshot_bytes);
+}
 
+void
+Castro::clear_retry_snapshot ()
+{
+    for (int k = 0; k < num_state_type; k++) {
+        if (prev_state[k]) {
+            retry_snapshot_bytes -= retry_snapshot_nbytes(*prev_state[k]);
+            prev_state[k].reset();
+        }
+    }
 }
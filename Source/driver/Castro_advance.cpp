@@ -73,6 +73,12 @@ Castro::advance (Real time,
 #ifdef TRUE_SDC
     } else if (time_integration_method == SpectralDeferredCorrections) {
 
+      // the SDC advance only integrates this level, so the fine levels
+      // need to take their own (subcycled) steps
+      if (max_level_to_advance > level) {
+        amrex::Error("True SDC with AMR requires amr.subcycling_mode != None");
+      }
+
       for (int iter = 0; iter < sdc_order+sdc_extra; ++iter) {
         sdc_iteration = iter;
         dt_new = do_advance_sdc(time, dt, amr_iteration, amr_ncycle);
@@ -295,7 +301,20 @@ Castro::finalize_do_advance (Real time, Real dt)
     }
 #endif
 
+#ifdef AMREX_PARTICLES
+    // If the tracer particles are pushed with the velocity in Sborder,
+    // advance_particles clears it once they have moved.  This is only
+    // the old-time state for CTU and simplified SDC; the true SDC
+    // advance refills Sborder at other times.
+
+    if (!(TracerPC && particles::advect_method != 0 &&
+          (time_integration_method == CornerTransportUpwind ||
+           time_integration_method == SimplifiedSpectralDeferredCorrections))) {
+        Sborder.clear();
+    }
+#else
     Sborder.clear();
+#endif
 
     return status;
 }
@@ -471,12 +490,10 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration)
                   S_old, time, S_old.nGrow());
 
 
-    // Initialize the previous state data container now, so that we can
-    // always ask if it has valid data.
+    // Start the step without any retry snapshot, so that we can
+    // always ask whether one has been taken.
 
-    for (int k = 0; k < num_state_type; ++k) {
-        prev_state[k] = std::make_unique<StateData>();
-    }
+    clear_retry_snapshot();
 
 
     // Allocate space for the primitive variables.
@@ -535,6 +552,29 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration)
       }
 #endif
 
+      // with AMR, we need to keep the fluxes at each node so we can
+      // construct the fluxes that correspond to the final update
+      if (do_reflux == 1 && parent->maxLevel() > 0) {
+        sdc_node_fluxes.resize(SDC_NODES);
+        for (int n = 0; n < SDC_NODES; ++n) {
+          sdc_node_fluxes[n].resize(AMREX_SPACEDIM);
+          for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            sdc_node_fluxes[n][dir] = std::make_unique<MultiFab>(getEdgeBoxArray(dir), dmap, NUM_STATE, 0);
+            sdc_node_fluxes[n][dir]->setVal(0.0);
+          }
+        }
+
+#if (AMREX_SPACEDIM <= 2)
+        if (!Geom().IsCartesian()) {
+          sdc_node_P_radial.resize(SDC_NODES);
+          for (int n = 0; n < SDC_NODES; ++n) {
+            sdc_node_P_radial[n] = std::make_unique<MultiFab>(getEdgeBoxArray(0), dmap, 1, 0);
+            sdc_node_P_radial[n]->setVal(0.0);
+          }
+        }
+#endif
+      }
+
     }
 #endif
 
@@ -545,6 +585,12 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration)
         mass_fluxes[dir]->setVal(0.0);
     }
 
+#ifdef MHD
+    for (int dir = 0; dir < 3; ++dir) {
+        electric[dir]->setVal(0.0);
+    }
+#endif
+
 #if (AMREX_SPACEDIM <= 2)
     if (!Geom().IsCartesian()) {
         P_radial.setVal(0.0);
@@ -611,7 +657,7 @@ Castro::finalize_advance()
     source_corrector.clear();
 
     if (!keep_prev_state) {
-        amrex::FillNull(prev_state);
+        clear_retry_snapshot();
     }
 
 #ifdef TRUE_SDC
@@ -622,6 +668,10 @@ Castro::finalize_advance()
 #ifdef REACTIONS
       R_old.clear();
       Sburn.clear();
+#endif
+      sdc_node_fluxes.clear();
+#if (AMREX_SPACEDIM <= 2)
+      sdc_node_P_radial.clear();
 #endif
     }
 #endif
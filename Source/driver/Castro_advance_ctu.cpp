@@ -185,6 +185,8 @@ Castro::retry_advance_ctu(Real dt, const advance_status& status)
         // be useful to us at the end of the timestep when we need
         // to restore the original old data.
 
+        num_retries += 1;
+
         for (int lev = level; lev <= max_level_to_advance; ++lev) {
             getLevel(lev).save_data_for_retry();
 
@@ -486,15 +488,15 @@ Castro::subcycle_advance_ctu(const Real time, const Real dt, int amr_iteration,
         // data so that externally it appears like we took only
         // a single timestep. We'll do this as a swap so that
         // we still have the last iteration's old data if we need
-        // it later.
+        // it later. State types that were skipped by the retry
+        // snapshot simply keep the last iteration's old data.
 
         for (int lev = level; lev <= max_level_to_advance; ++lev) {
             for (int k = 0; k < num_state_type; k++) {
-                if (getLevel(lev).prev_state[k]->hasOldData()) {
-                    getLevel(lev).state[k].replaceOldData(*getLevel(lev).prev_state[k]);
+                if (getLevel(lev).prev_state[k]) {
+                    std::swap(getLevel(lev).get_old_data(k), *getLevel(lev).prev_state[k]);
                 }
                 getLevel(lev).state[k].setTimeLevel(time + dt, dt, 0.0);
-                getLevel(lev).prev_state[k]->setTimeLevel(time + dt, dt_subcycle, 0.0);
             }
         }
 
@@ -71,12 +71,23 @@ Castro::do_advance_sdc (Real time,
     Real node_time = time + dt_sdc[m]*dt;
 
     // fill Sborder with the starting node's info -- we use S_new as
-    // our staging area.  Note we need to pass new_time here to the
-    // FillPatch so it only pulls from the new MF -- this will not
-    // work for multilevel.
+    // our staging area.  The ghost cells on coarse-fine boundaries
+    // come from the coarse level interpolated to the node time.
     MultiFab::Copy(S_new, *(k_new[m]), 0, 0, S_new.nComp(), 0);
     clean_state(S_new, cur_time, 0);
-    expand_state(Sborder, cur_time, NUM_GROW);
+    expand_sdc_node_state(Sborder, m, node_time, NUM_GROW);
+
+    // with AMR, the last iteration replaces the fluxes from the
+    // previous iteration at nodes 0 < m < SDC_NODES-1 over the
+    // interval to the next node.  The stored fluxes at this node are
+    // still the previous iteration's here, so we add the part of
+    // them that the update keeps now.
+    const bool last_iteration = sdc_iteration == sdc_order+sdc_extra-1;
+
+    if (!sdc_node_fluxes.empty() && last_iteration && m > 0) {
+      Real dt_frac = (m < SDC_NODES-1) ? dt_sdc[m+1] - dt_sdc[m] : 0.0_rt;
+      add_sdc_node_fluxes(m, node_weights[m] - dt_frac);
+    }
 
 
     // the next chunk of code constructs the advective term for the
@@ -101,7 +112,10 @@ Castro::do_advance_sdc (Real time,
               // if we are 4th order, convert to cell-center Sborder -> Sborder_cc
               // we'll use Sburn for this memory buffer at the moment
 
-              for (MFIter mfi(S_new); mfi.isValid(); ++mfi) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+              for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
                   const Box& gbx = mfi.growntilebox(1);
 
                   make_cell_center(gbx, Sborder.array(mfi), Sburn.array(mfi), domain_lo, domain_hi);
@@ -112,23 +126,26 @@ Castro::do_advance_sdc (Real time,
               do_old_sources(old_source, Sburn, Sburn, node_time, dt, apply_sources_to_state);
 
               // fill the ghost cells for the sources -- note since we have
-              // not defined the new_source yet, we either need to copy this
-              // into new_source for the time-interpolation in the ghost
-              // fill to make sense, or so long as we are not multilevel,
-              // just use the old time (prev_time) in the fill instead of
-              // the node time (time)
+              // not defined the new_source yet, we use the old time
+              // (prev_time) in the fill instead of the node time.  With
+              // AMR, this means the sources in the ghost cells on
+              // coarse-fine boundaries come from the start of the coarse
+              // step.
               AmrLevel::FillPatch(*this, old_source, old_source.nGrow(), prev_time, Source_Type, 0, NSRC);
 
-              // Now convert to cell averages.  This loop cannot be tiled.
-              FArrayBox tmp;
+              // Now convert to cell averages.  We work from a copy of
+              // the centered sources, so the tiles don't read zones that
+              // a neighboring tile has already converted.
+              MultiFab old_source_cc(grids, dmap, NSRC, 1);
+              MultiFab::Copy(old_source_cc, old_source, 0, 0, NSRC, 1);
 
-              for (MFIter mfi(S_new); mfi.isValid(); ++mfi) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+              for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
                   const Box& bx = mfi.tilebox();
 
-                  tmp.resize(bx, 1, The_Async_Arena());
-                  auto tmp_arr = tmp.array();
-
-                  make_fourth_in_place(bx, old_source.array(mfi), tmp_arr, domain_lo, domain_hi);
+                  make_fourth_average(bx, old_source.array(mfi), old_source_cc.const_array(mfi), domain_lo, domain_hi);
               }
 
           } else {
@@ -168,6 +185,15 @@ Castro::do_advance_sdc (Real time,
       A_new[m]->setVal(0.0);
       construct_mol_hydro_source(time, dt, *A_new[m]);
 
+      if (!sdc_node_fluxes.empty()) {
+        if (m == 0) {
+          // node 0 never changes, so its fluxes are added once
+          add_sdc_node_fluxes(0, node_weights[0]);
+        } else if (last_iteration) {
+          add_sdc_node_fluxes(m, dt_sdc[m+1] - dt_sdc[m]);
+        }
+      }
+
     } // end of the m = 0 sdc_iter > 0 check
 
     // also, if we are the first SDC iteration, we haven't yet stored
@@ -236,7 +262,7 @@ Castro::do_advance_sdc (Real time,
   for (int m = 1; m < SDC_NODES; ++m) {
     // TODO: do we need a clean state here?
     MultiFab::Copy(S_new, *(k_new[m]), 0, 0, S_new.nComp(), 0);
-    expand_state(Sburn, cur_time, 2);
+    expand_sdc_node_state(Sburn, m, time + dt_sdc[m]*dt, 2);
     bool input_is_average = true;
     construct_old_react_source(Sburn, *(R_old[m]), input_is_average);
   }
@@ -293,14 +319,20 @@ Castro::do_advance_sdc (Real time,
     expand_state(Sborder, cur_time, 2);
   }
 
-  FArrayBox U_center;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+
   FArrayBox R_center;
   FArrayBox tmp;
 
-  // this cannot be tiled
-  for (MFIter mfi(R_new); mfi.isValid(); ++mfi) {
+  for (MFIter mfi(R_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
     const Box& bx = mfi.tilebox();
-    const Box& obx = mfi.growntilebox(1);
+
+    // the in-place conversion to averages below needs R_center on
+    // the ghost cells of the tile, not just of the box
+    const Box& obx = amrex::grow(bx, 1);
 
     if (sdc_order == 4) {
 
@@ -335,6 +367,8 @@ Castro::do_advance_sdc (Real time,
 
   }
 
+  } // OMP loop
+
   if (sdc_order == 4) {
     Sborder.clear();
   }
@@ -344,5 +378,61 @@ Castro::do_advance_sdc (Real time,
   return dt;
 }
 
+
+
+void
+Castro::expand_sdc_node_state (MultiFab& S, int m, Real node_time, int ng)
+{
+  BL_PROFILE("Castro::expand_sdc_node_state()");
+
+  const Real prev_time = state[State_Type].prevTime();
+  const Real  cur_time = state[State_Type].curTime();
+
+  if (m == 0) {
+    // node 0 is the old state (k_new[0] is an alias of S_old), so
+    // a fill at the old time does everything we need
+    expand_state(S, prev_time, ng);
+    return;
+  }
+
+  // S_new holds the state at this node, so we temporarily move the
+  // new time level to the node time.  The FillPatch then takes the
+  // valid data only from S_new and interpolates the coarse level to
+  // the node time for the coarse-fine ghost cells.  On level 0 this
+  // is just a copy plus the physical boundary fill.
+
+  state[State_Type].setNewTimeLevel(node_time);
+
+  expand_state(S, node_time, ng);
+
+  state[State_Type].setNewTimeLevel(cur_time);
+}
+
+
+void
+Castro::add_sdc_node_fluxes (int m, Real weight)
+{
+  BL_PROFILE("Castro::add_sdc_node_fluxes()");
+
+  // The fluxes at each node are already scaled by dt, so the
+  // time-integrated flux is a weighted sum over the nodes.  Node 0
+  // is added with its quadrature weight.  The nodes 0 < m <
+  // SDC_NODES-1 are added with their quadrature weight for the
+  // previous iteration, less the interval to the next node.  That
+  // interval is then added for the last iteration.  The last node
+  // only enters through the previous iteration.  This is exactly
+  // what the conservative update does.
+
+  for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+    MultiFab::Saxpy(*fluxes[idir], weight, *sdc_node_fluxes[m][idir], 0, 0, NUM_STATE, 0);
+  }
+
+#if (AMREX_SPACEDIM <= 2)
+  if (!Geom().IsCartesian()) {
+    MultiFab::Saxpy(P_radial, weight, *sdc_node_P_radial[m], 0, 0, 1, 0);
+  }
+#endif
+}
+
 #endif
 #endif
@@ -12,6 +12,7 @@
 #include <Castro.H>
 #include <Castro_io.H>
 #include <AMReX_ParmParse.H>
+#include <plotfile_writer.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -206,6 +207,33 @@ Castro::restart (Amr&     papa,
     }
 #endif
 
+    if (hydro_tile_size_autotune == 1 && level == 0)
+    {
+        // get the hydro tile sizes we tuned before the checkpoint --
+        // all processors read this, so there is no need for a broadcast
+        std::ifstream TileFile;
+        std::string FullPathTileFile = parent->theRestartFile();
+        FullPathTileFile += "/HydroTileSize";
+        TileFile.open(FullPathTileFile.c_str(), std::ios::in);
+
+        int lev;
+        IntVect tile_size;
+        IntVect tuned_box_size;
+
+        while (TileFile >> lev >> tile_size >> tuned_box_size) {
+            if (hydro_tile_tuning.size() <= lev) {
+                hydro_tile_tuning.resize(lev+1);
+            }
+
+            hydro_tile_tuning[lev].tuned = 1;
+            hydro_tile_tuning[lev].tile_size = tile_size;
+            hydro_tile_tuning[lev].tuned_box_size = tuned_box_size;
+
+            amrex::Print() << "  Based on the checkpoint, setting the hydro tile size on level "
+                           << lev << " to " << tile_size << ".\n";
+        }
+    }
+
     if (level == 0)
     {
         // get problem-specific stuff -- note all processors do this,
@@ -489,6 +517,24 @@ Castro::checkPoint(const std::string& dir,
         }
 #endif
 
+        if (hydro_tile_size_autotune == 1) {
+            // store the tuned hydro tile sizes, together with the box
+            // size they were tuned for
+            std::ofstream TileFile;
+            std::string FullPathTileFile = dir;
+            FullPathTileFile += "/HydroTileSize";
+            TileFile.open(FullPathTileFile.c_str(), std::ios::out);
+
+            for (int lev = 0; lev < hydro_tile_tuning.size(); ++lev) {
+                if (hydro_tile_tuning[lev].tuned == 1) {
+                    TileFile << lev << " " << hydro_tile_tuning[lev].tile_size
+                             << " " << hydro_tile_tuning[lev].tuned_box_size << std::endl;
+                }
+            }
+
+            TileFile.close();
+        }
+
         {
             // store any problem-specific stuff
             problem_checkpoint(dir);
@@ -562,6 +608,11 @@ Castro::writeJobInfo (const std::string& dir, const Real io_time)
 #endif
   jobInfoFile << "\n";
   jobInfoFile << "hydro tile size:         " << hydro_tile_size << "\n";
+  for (int lev = 0; lev < hydro_tile_tuning.size(); ++lev) {
+      if (hydro_tile_tuning[lev].tuned == 1) {
+          jobInfoFile << "  tuned on level " << lev << ":       " << hydro_tile_tuning[lev].tile_size << "\n";
+      }
+  }
 
   jobInfoFile << "\n";
 #ifdef AMREX_USE_GPU
@@ -1145,51 +1196,57 @@ Castro::plotFileOutput(const std::string& dir,
         }
     }
     //
-    // We combine all of the multifabs -- state, derived, etc -- into one
-    // multifab -- plotMF.
+    // Each plotfile variable -- state, derived, etc -- is an item that
+    // knows how to fill its components of a multifab.
     // NOTE: we are assuming that each state variable has one component,
     // but a derived variable is allowed to have multiple components.
-    int       cnt   = 0;
+    //
     const int nGrow = 0;
-    MultiFab  plotMF(grids,dmap,n_data_items,nGrow);
-    MultiFab* this_dat = nullptr;
+    std::vector<plotfile_writer::PlotItem> plot_items;
     //
     // Cull data from state variables -- use no ghost cells.
     //
     for (const auto& [typ, comp] : plot_var_map) {
-        this_dat = &state[typ].newData();
-        MultiFab::Copy(plotMF, *this_dat, comp, cnt, 1, nGrow);
-        cnt++;
+        plot_items.push_back({1, [this, typ=typ, comp=comp, nGrow] (MultiFab& mf, int dcomp)
+        {
+            MultiFab::Copy(mf, state[typ].newData(), comp, dcomp, 1, nGrow);
+        }});
     }
     //
     // Cull data from derived variables.
     //
-    if (!dlist.empty())
-    {
-        for (const auto & dd : dlist) {
-
-            if ((parent->isDerivePlotVar(dd.name()) && is_small == 0) ||
-                (parent->isDeriveSmallPlotVar(dd.name()) && is_small == 1)) {
-
-                auto derive_dat = derive(dd.variableName(0), cur_time, nGrow);
-                MultiFab::Copy(plotMF, *derive_dat, 0, cnt, dd.numDerive(), nGrow);
-                cnt = cnt + dd.numDerive();
+    for (const auto& name : derive_names) {
+        const DeriveRec* rec = derive_lst.get(name);
+        plot_items.push_back({rec->numDerive(), [this, rec, cur_time, nGrow] (MultiFab& mf, int dcomp)
+        {
+#ifdef AMREX_PARTICLES
+            if (rec->name() == "particle_count" || rec->name() == "total_particle_count") {
+                auto derive_dat = derive(rec->variableName(0), cur_time, nGrow);
+                MultiFab::Copy(mf, *derive_dat, 0, dcomp, rec->numDerive(), nGrow);
+                return;
             }
-        }
+#endif
+            derive(rec->variableName(0), cur_time, mf, dcomp);
+        }});
     }
 
 #ifdef RADIATION
     if (Radiation::nplotvar > 0) {
-        MultiFab::Copy(plotMF,*(radiation->plotvar[level]),0,cnt,Radiation::nplotvar,0);
-        cnt += Radiation::nplotvar;
+        plot_items.push_back({Radiation::nplotvar, [this] (MultiFab& mf, int dcomp)
+        {
+            MultiFab::Copy(mf, *(radiation->plotvar[level]), 0, dcomp, Radiation::nplotvar, 0);
+        }});
     }
 #endif
 
 #ifdef REACTIONS
 #ifndef TRUE_SDC
     if (store_burn_weights) {
-        MultiFab::Copy(plotMF, getLevel(level).burn_weights, 0, cnt, static_cast<int>(Castro::burn_weight_names.size()), 0);
-        cnt += static_cast<int>(Castro::burn_weight_names.size());  // NOLINT(clang-analyzer-deadcode.DeadStores)
+        const int nweights = static_cast<int>(Castro::burn_weight_names.size());
+        plot_items.push_back({nweights, [this, nweights] (MultiFab& mf, int dcomp)
+        {
+            MultiFab::Copy(mf, getLevel(level).burn_weights, 0, dcomp, nweights, 0);
+        }});
     }
 #endif
 #endif
@@ -1200,16 +1257,53 @@ Castro::plotFileOutput(const std::string& dir,
     std::string TheFullPath = FullPath;
     TheFullPath += BaseName;
 
+    //
+    // Plotfiles can be written in single precision. The FAB format is
+    // global (and also used for checkpoints), so we only switch it for
+    // the duration of this write.
+    //
+    const bool write_float32 = (is_small == 0) ? plot_float32 : small_plot_float32;
+
+    const FABio::Format saved_format = FArrayBox::getFormat();
+    if (write_float32) {
+        FArrayBox::setFormat(FABio::FAB_NATIVE_32);
+    }
+
     const Real io_start_time = ParallelDescriptor::second();
 
-    if (amrex::AsyncOut::UseAsyncOut()) {
-        VisMF::AsyncWrite(std::move(plotMF),TheFullPath);
+    if (plot_chunk_size > 0 && plot_chunk_size < n_data_items &&
+        plotfile_writer::can_write_chunked()) {
+
+        // Derive and write a bounded number of components at a time.
+
+        plotfile_writer::write_chunked(plot_items, grids, dmap, TheFullPath, how, plot_chunk_size);
+
     } else {
-        VisMF::Write(plotMF,TheFullPath,how,true);
+
+        // We combine all of the items into one multifab -- plotMF.
+
+        MultiFab plotMF(grids,dmap,n_data_items,nGrow);
+
+        int cnt = 0;
+        for (const auto& item : plot_items) {
+            item.fill(plotMF, cnt);
+            cnt += item.ncomp;
+        }
+
+        // Asynchronous output always writes native doubles, so it
+        // can't be used for a single precision plotfile.
+
+        if (amrex::AsyncOut::UseAsyncOut() && !write_float32) {
+            VisMF::AsyncWrite(std::move(plotMF),TheFullPath);
+        } else {
+            VisMF::Write(plotMF,TheFullPath,how,true);
+        }
     }
 
     const Real io_time = ParallelDescriptor::second() - io_start_time;
 
+    FArrayBox::setFormat(saved_format);
+
     if (level == 0 && ParallelDescriptor::IOProcessor()) {
         writeJobInfo(dir, io_time);
     }
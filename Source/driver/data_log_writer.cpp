@@ -0,0 +1,247 @@
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <castro_params.H>
+#include <data_log_writer.H>
+
+using namespace amrex;
+
+namespace data_log_writer
+{
+
+namespace {
+
+    // A record whose reductions may still be in flight. The send
+    // buffers have to stay alive until the reductions complete.
+
+    struct PendingRecord
+    {
+        std::vector<Real> sum;
+        std::vector<Real> max;
+        std::vector<Real> sum_result;
+        std::vector<Real> max_result;
+        formatter_t formatter;
+#ifdef BL_USE_MPI
+        MPI_Request requests[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+#endif
+    };
+
+    std::deque<std::unique_ptr<PendingRecord>> pending;
+
+    // State of the writer thread (I/O processor only).
+
+    std::thread writer;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::condition_variable idle_cv;
+    std::deque<std::function<void()>> queue;
+    bool writer_busy = false;
+    bool writer_stop = false;
+    bool writer_running = false;
+
+    void
+    writer_loop ()
+    {
+        while (true) {
+
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex);
+                queue_cv.wait(lock, [] { return writer_stop || !queue.empty(); });
+
+                if (queue.empty()) {
+                    writer_busy = false;
+                    idle_cv.notify_all();
+                    return;
+                }
+
+                task = std::move(queue.front());
+                queue.pop_front();
+                writer_busy = true;
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                writer_busy = false;
+            }
+            idle_cv.notify_all();
+
+        }
+    }
+
+    void
+    write_record (std::unique_ptr<PendingRecord> record)
+    {
+        if (!ParallelDescriptor::IOProcessor()) {
+            return;
+        }
+
+        if (!writer_running) {
+            record->formatter(record->sum_result, record->max_result);
+            return;
+        }
+
+        std::shared_ptr<PendingRecord> shared_record(std::move(record));
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            queue.emplace_back([=] () { shared_record->formatter(shared_record->sum_result, shared_record->max_result); });
+        }
+        queue_cv.notify_one();
+    }
+
+    bool
+    is_complete (PendingRecord& record, bool wait)
+    {
+#ifdef BL_USE_MPI
+        if (wait) {
+            MPI_Waitall(2, record.requests, MPI_STATUSES_IGNORE);
+            return true;
+        }
+
+        int flag = 0;
+        MPI_Testall(2, record.requests, &flag, MPI_STATUSES_IGNORE);
+        return flag != 0;
+#else
+        amrex::ignore_unused(record, wait);
+        return true;
+#endif
+    }
+
+    void
+    advance_pending (bool wait)
+    {
+        // Retire records strictly in submission order so that the logs
+        // are written in the same order as the timesteps.
+
+        while (!pending.empty() && is_complete(*pending.front(), wait)) {
+            write_record(std::move(pending.front()));
+            pending.pop_front();
+        }
+    }
+
+}
+
+void
+initialize ()
+{
+    if (writer_running || !castro::async_data_logs || !ParallelDescriptor::IOProcessor()) {
+        return;
+    }
+
+    writer_stop = false;
+    writer = std::thread(writer_loop);
+    writer_running = true;
+}
+
+void
+submit (std::vector<Real> sum, std::vector<Real> max, formatter_t formatter)
+{
+    auto record = std::make_unique<PendingRecord>();
+
+    record->sum = std::move(sum);
+    record->max = std::move(max);
+    record->formatter = std::move(formatter);
+
+    record->sum_result.resize(record->sum.size(), 0.0_rt);
+    record->max_result.resize(record->max.size(), 0.0_rt);
+
+#ifdef BL_USE_MPI
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+    MPI_Datatype datatype = ParallelDescriptor::Mpi_typemap<Real>::type();
+
+    if (!record->sum.empty()) {
+        MPI_Ireduce(record->sum.data(), record->sum_result.data(), static_cast<int>(record->sum.size()),
+                    datatype, MPI_SUM, IOProc, comm, &record->requests[0]);
+    }
+
+    if (!record->max.empty()) {
+        MPI_Ireduce(record->max.data(), record->max_result.data(), static_cast<int>(record->max.size()),
+                    datatype, MPI_MAX, IOProc, comm, &record->requests[1]);
+    }
+#else
+    record->sum_result = record->sum;
+    record->max_result = record->max;
+#endif
+
+    pending.push_back(std::move(record));
+
+    // Without the writer thread we behave like the original blocking
+    // implementation: the record is reduced and written immediately.
+
+    advance_pending(!castro::async_data_logs);
+}
+
+void
+poll ()
+{
+    advance_pending(false);
+}
+
+void
+flush ()
+{
+    advance_pending(true);
+
+    if (writer_running) {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        idle_cv.wait(lock, [] { return queue.empty() && !writer_busy; });
+    }
+}
+
+void
+finalize ()
+{
+    flush();
+
+    if (writer_running) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            writer_stop = true;
+        }
+        queue_cv.notify_one();
+        writer.join();
+        writer_running = false;
+    }
+}
+
+void
+write_binary_row (const std::string& filename,
+                  const std::vector<std::string>& names,
+                  const std::vector<Real>& values)
+{
+    const bool new_file = !amrex::FileExists(filename);
+
+    std::ofstream log;
+    log.open(filename, std::ios::out | std::ios::app | std::ios::binary);
+
+    if (!log.good()) {
+        amrex::FileOpenFailed(filename);
+    }
+
+    if (new_file) {
+        log << "CASTRO_BINARY_LOG" << '\n';
+        log << names.size() << '\n';
+        for (const auto& name : names) {
+            log << name << '\n';
+        }
+    }
+
+    for (auto value : values) {
+        auto v = static_cast<double>(value);
+        log.write(reinterpret_cast<const char*>(&v), sizeof(double));
+    }
+}
+
+}
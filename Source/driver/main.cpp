@@ -22,7 +22,11 @@
 #include <ctime>
 
 #include <Castro.H>
+#include <Castro_bc_fill_nd.H>
 #include <Castro_io.H>
+#ifdef GRAVITY
+#include <Gravity.H>
+#endif
 
 #include <global.H>
 
@@ -242,6 +246,48 @@ main (int   argc,
         std::cout << "\n";
     }
 
+    if (Castro::num_retries > 0) {
+
+        Real retry_snapshot_time = Castro::retry_snapshot_time;
+
+        ParallelDescriptor::ReduceRealMax(retry_snapshot_time, IOProc);
+
+        if (ParallelDescriptor::IOProcessor())
+        {
+            std::cout << "  Number of retries: " << Castro::num_retries << "\n";
+            std::cout << "  Peak retry snapshot memory (MB, all ranks): " << std::fixed << std::setprecision(3)
+                      << static_cast<Real>(Castro::retry_snapshot_peak_bytes) / (1024.0 * 1024.0) << "\n";
+            std::cout << "  Time spent saving retry snapshots: " << retry_snapshot_time << "\n";
+            std::cout << "\n";
+        }
+
+    }
+
+#ifdef GRAVITY
+    {
+        Long hse_hits;
+        Long hse_misses;
+        hse_fill_cache_stats(hse_hits, hse_misses);
+
+        ParallelDescriptor::ReduceLongSum(hse_hits, IOProc);
+        ParallelDescriptor::ReduceLongSum(hse_misses, IOProc);
+
+        if (ParallelDescriptor::IOProcessor() && hse_hits + hse_misses > 0)
+        {
+            std::cout << "  HSE boundary columns copied from the cache: " << hse_hits
+                      << " of " << hse_hits + hse_misses << "\n";
+            std::cout << "\n";
+        }
+    }
+
+    if (Gravity::num_syncs_solved + Gravity::num_syncs_skipped > 0 && ParallelDescriptor::IOProcessor())
+    {
+        std::cout << "  Gravity sync solves done: " << Gravity::num_syncs_solved
+                  << ", skipped: " << Gravity::num_syncs_skipped << "\n";
+        std::cout << "\n";
+    }
+#endif
+
     if (auto* arena = dynamic_cast<CArena*>(amrex::The_Arena()))
     {
         //
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+#include <AMReX_AsyncOut.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <plotfile_writer.H>
+
+using namespace amrex;
+
+namespace plotfile_writer
+{
+
+bool
+can_write_chunked ()
+{
+    // We write the FAB headers ourselves and then the data one group of
+    // components at a time, which only maps onto the binary FAB formats
+    // and the version of the VisMF header that has per-FAB headers.
+
+    const FABio::Format format = FArrayBox::getFormat();
+
+    return !AsyncOut::UseAsyncOut() &&
+           VisMF::GetHeaderVersion() == VisMF::Header::Version_v1 &&
+           format != FABio::FAB_ASCII && format != FABio::FAB_8BIT;
+}
+
+void
+write_chunked (const std::vector<PlotItem>& items,
+               const BoxArray& ba,
+               const DistributionMapping& dm,
+               const std::string& mf_name,
+               VisMF::How how,
+               int chunk_size)
+{
+    BL_PROFILE("plotfile_writer::write_chunked()");
+
+    AMREX_ALWAYS_ASSERT(chunk_size > 0);
+
+    int ncomp = 0;
+    for (const auto& item : items) {
+        ncomp += item.ncomp;
+    }
+
+    const int nfabs = static_cast<int>(ba.size());
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
+
+    // Ranks are assigned to the data files in contiguous blocks, and
+    // within a file the FABs are ordered by rank and then by index.
+
+    const int nfiles = std::max(1, std::min(VisMF::GetNOutFiles(), nprocs));
+
+    auto file_number = [=] (int proc) -> int
+    {
+        return static_cast<int>(static_cast<Long>(proc) * nfiles / nprocs);
+    };
+
+    std::string mf_base = mf_name;
+    std::string mf_dir;
+    if (auto slash = mf_name.rfind('/'); slash != std::string::npos) {
+        mf_base = mf_name.substr(slash + 1);
+        mf_dir = mf_name.substr(0, slash + 1);
+    }
+
+    auto file_name = [&] (int f) -> std::string
+    {
+        return amrex::Concatenate(mf_base + "_D_", f, 5);
+    };
+
+    const FABio& fabio = FArrayBox::getFABio();
+
+    // The number of bytes one value takes on disk in the current FAB
+    // format.
+
+    Long value_bytes = 0;
+    {
+        FArrayBox probe(Box(IntVect(0), IntVect(0)), 1, The_Pinned_Arena());
+        probe.setVal<RunOn::Host>(0.0_rt);
+
+        std::ostringstream ss;
+        fabio.write(ss, probe, 0, 1);
+        value_bytes = static_cast<Long>(ss.str().size());
+    }
+
+    // Every rank can work out where every FAB goes, since the size of
+    // a FAB on disk only depends on its box and the number of
+    // components.
+
+    Vector<std::string> fab_header(nfabs);
+    Vector<Long> fab_offset(nfabs);
+
+    Vector<int> order(nfabs);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&] (int a, int b) { return dm[a] < dm[b]; });
+
+    Vector<Long> file_end(nfiles, 0);
+
+    for (int i : order) {
+        std::ostringstream ss;
+        fabio.write_header(ss, FArrayBox(ba[i], ncomp, false), ncomp);
+        fab_header[i] = ss.str();
+
+        const int f = file_number(dm[i]);
+        fab_offset[i] = file_end[f];
+        file_end[f] += static_cast<Long>(fab_header[i].size()) +
+                       static_cast<Long>(ncomp) * ba[i].numPts() * value_bytes;
+    }
+
+    // The first rank of each file creates it, then every rank writes
+    // the headers of its own FABs.
+
+    const int my_file = file_number(myproc);
+    const std::string my_file_name = mf_dir + file_name(my_file);
+
+    if (myproc == 0 || file_number(myproc - 1) != my_file) {
+        std::ofstream ofs(my_file_name, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!ofs.good()) {
+            amrex::FileOpenFailed(my_file_name);
+        }
+    }
+
+    ParallelDescriptor::Barrier();
+
+    auto open_data_file = [&] (std::fstream& fs)
+    {
+        fs.open(my_file_name, std::ios::in | std::ios::out | std::ios::binary);
+        if (!fs.good()) {
+            amrex::FileOpenFailed(my_file_name);
+        }
+    };
+
+    {
+        std::fstream fs;
+        open_data_file(fs);
+
+        for (int i = 0; i < nfabs; ++i) {
+            if (dm[i] == myproc) {
+                fs.seekp(fab_offset[i]);
+                fs.write(fab_header[i].data(), static_cast<std::streamsize>(fab_header[i].size()));
+            }
+        }
+    }
+
+    // Per-FAB, per-component extrema for the header. Each rank fills
+    // in its own FABs and they are summed onto the I/O processor.
+
+    Vector<Real> fab_min(static_cast<Long>(nfabs) * ncomp, 0.0_rt);
+    Vector<Real> fab_max(static_cast<Long>(nfabs) * ncomp, 0.0_rt);
+
+    std::size_t first = 0;
+    int comp0 = 0;
+
+    while (first < items.size()) {
+
+        // Group items until the chunk is full.
+
+        std::size_t last = first;
+        int nc = 0;
+        while (last < items.size() && (nc == 0 || nc + items[last].ncomp <= chunk_size)) {
+            nc += items[last].ncomp;
+            ++last;
+        }
+
+        MultiFab chunk(ba, dm, nc, 0);
+
+        int dcomp = 0;
+        for (std::size_t n = first; n < last; ++n) {
+            items[n].fill(chunk, dcomp);
+            dcomp += items[n].ncomp;
+        }
+
+        std::fstream fs;
+        open_data_file(fs);
+
+        for (MFIter mfi(chunk); mfi.isValid(); ++mfi) {
+            const int i = mfi.index();
+            const FArrayBox& fab = chunk[mfi];
+
+            for (int n = 0; n < nc; ++n) {
+                fab_min[static_cast<Long>(i) * ncomp + comp0 + n] = fab.min<RunOn::Device>(n);
+                fab_max[static_cast<Long>(i) * ncomp + comp0 + n] = fab.max<RunOn::Device>(n);
+            }
+
+#ifdef AMREX_USE_GPU
+            FArrayBox host_fab(fab.box(), nc, The_Pinned_Arena());
+            Gpu::dtoh_memcpy(host_fab.dataPtr(), fab.dataPtr(), fab.nBytes());
+#else
+            const FArrayBox& host_fab = fab;
+#endif
+
+            // Components are stored one after another within a FAB.
+
+            fs.seekp(fab_offset[i] + static_cast<Long>(fab_header[i].size()) +
+                     static_cast<Long>(comp0) * fab.box().numPts() * value_bytes);
+            fabio.write(fs, host_fab, 0, nc);
+        }
+
+        fs.close();
+        if (fs.fail()) {
+            amrex::Error("plotfile_writer: failed writing " + my_file_name);
+        }
+
+        first = last;
+        comp0 += nc;
+    }
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+    ParallelDescriptor::ReduceRealSum(fab_min.data(), static_cast<int>(fab_min.size()), IOProc);
+    ParallelDescriptor::ReduceRealSum(fab_max.data(), static_cast<int>(fab_max.size()), IOProc);
+
+    if (ParallelDescriptor::IOProcessor()) {
+
+        VisMF::Header hdr;
+
+        hdr.m_vers = VisMF::Header::Version_v1;
+        hdr.m_how = how;
+        hdr.m_ncomp = ncomp;
+        hdr.m_ngrow = IntVect(0);
+        hdr.m_ba = ba;
+
+        hdr.m_fod.resize(nfabs);
+        hdr.m_min.resize(nfabs);
+        hdr.m_max.resize(nfabs);
+
+        for (int i = 0; i < nfabs; ++i) {
+            hdr.m_fod[i] = VisMF::FabOnDisk(file_name(file_number(dm[i])), fab_offset[i]);
+
+            hdr.m_min[i].assign(fab_min.begin() + static_cast<Long>(i) * ncomp,
+                                fab_min.begin() + static_cast<Long>(i + 1) * ncomp);
+            hdr.m_max[i].assign(fab_max.begin() + static_cast<Long>(i) * ncomp,
+                                fab_max.begin() + static_cast<Long>(i + 1) * ncomp);
+        }
+
+        const std::string header_name = mf_name + "_H";
+
+        std::ofstream hfile(header_name);
+        if (!hfile.good()) {
+            amrex::FileOpenFailed(header_name);
+        }
+
+        hfile << hdr;
+        hfile.close();
+    }
+
+    ParallelDescriptor::Barrier();
+}
+
+}
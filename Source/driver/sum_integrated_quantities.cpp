@@ -7,6 +7,7 @@
 #endif
 
 #include <problem_diagnostics.H>
+#include <data_log_writer.H>
 
 using namespace amrex;
 
@@ -88,7 +89,8 @@ Castro::sum_integrated_quantities ()
         rho_K += ca_lev.volWgtSum("kineng", time, local_flag);
         rho_E += ca_lev.volWgtSum(S_new, UEDEN, local_flag);
 #ifdef GRAVITY
-        if (gravity->get_gravity_type() == "PoissonGrav") {
+        if (gravity->get_gravity_type() == "PoissonGrav" ||
+            gravity->get_gravity_type() == "MultipoleGrav") {
             rho_phi += ca_lev.volProductSum(S_new, phi_new, URHO, 0, local_flag);
         }
 #endif
@@ -190,75 +192,62 @@ Castro::sum_integrated_quantities ()
 
     }
 
-    if (verbose > 0)
-    {
+    // The reductions and the output are handed to the data log pipeline,
+    // so everything used by the formatters is captured by value.
 
-#ifdef HYBRID_MOMENTUM
+    const std::string gravity_type =
 #ifdef GRAVITY
-       const int nfoo = 17;
+        gravity->get_gravity_type();
 #else
-       const int nfoo = 16;
-#endif
-#else
-#ifdef GRAVITY
-       const int nfoo = 14;
-#else
-       const int nfoo = 13;
-#endif
+        "";
 #endif
 
-        Real foo[nfoo] = {mass, mom[0], mom[1], mom[2],
-                          com[0], com[1], com[2],
-                          ang_mom[0], ang_mom[1], ang_mom[2],
+    amrex::ignore_unused(gravity_type);
+
+    {
+        std::vector<Real> foo = {mass, mom[0], mom[1], mom[2],
+                                 com[0], com[1], com[2],
+                                 ang_mom[0], ang_mom[1], ang_mom[2],
 #ifdef HYBRID_MOMENTUM
-                          hyb_mom[0], hyb_mom[1], hyb_mom[2],
+                                 hyb_mom[0], hyb_mom[1], hyb_mom[2],
 #endif
 #ifdef GRAVITY
-                          rho_e, rho_K, rho_E, rho_phi};
+                                 rho_e, rho_K, rho_E, rho_phi};
 #else
-                          rho_e, rho_K, rho_E};
+                                 rho_e, rho_K, rho_E};
 #endif
 
-        const int nfoo_max = 3;
-
-        Real foo_max[nfoo_max] = {T_max, rho_max, ts_te_max};
-
-#ifdef BL_LAZY
-        Lazy::QueueReduction( [=] () mutable {
-#endif
-
-        ParallelDescriptor::ReduceRealSum(foo, nfoo, ParallelDescriptor::IOProcessorNumber());
-
-        ParallelDescriptor::ReduceRealMax(foo_max, nfoo_max, ParallelDescriptor::IOProcessorNumber());
-
-        if (ParallelDescriptor::IOProcessor()) {
+        std::vector<Real> foo_max = {T_max, rho_max, ts_te_max};
 
+        data_log_writer::submit(std::move(foo), std::move(foo_max),
+        [=] (const std::vector<Real>& foo_sum, const std::vector<Real>& foo_max_sum) mutable
+        {
             int i = 0;
-            mass       = foo[i++];
-            mom[0]     = foo[i++];
-            mom[1]     = foo[i++];
-            mom[2]     = foo[i++];
-            com[0]     = foo[i++];
-            com[1]     = foo[i++];
-            com[2]     = foo[i++];
-            ang_mom[0] = foo[i++];
-            ang_mom[1] = foo[i++];
-            ang_mom[2] = foo[i++];
+            mass       = foo_sum[i++];
+            mom[0]     = foo_sum[i++];
+            mom[1]     = foo_sum[i++];
+            mom[2]     = foo_sum[i++];
+            com[0]     = foo_sum[i++];
+            com[1]     = foo_sum[i++];
+            com[2]     = foo_sum[i++];
+            ang_mom[0] = foo_sum[i++];
+            ang_mom[1] = foo_sum[i++];
+            ang_mom[2] = foo_sum[i++];
 #ifdef HYBRID_MOMENTUM
-            hyb_mom[0] = foo[i++];
-            hyb_mom[1] = foo[i++];
-            hyb_mom[2] = foo[i++];
+            hyb_mom[0] = foo_sum[i++];
+            hyb_mom[1] = foo_sum[i++];
+            hyb_mom[2] = foo_sum[i++];
 #endif
-            rho_e      = foo[i++];
-            rho_K      = foo[i++];
-            rho_E      = foo[i++];
+            rho_e      = foo_sum[i++];
+            rho_K      = foo_sum[i++];
+            rho_E      = foo_sum[i++];
 #ifdef GRAVITY
-            rho_phi    = foo[i++];
+            rho_phi    = foo_sum[i++];
 
             // Total energy is 1/2 * rho * phi + rho * E for self-gravity,
             // and rho * phi + rho * E for externally-supplied gravity.
-            std::string gravity_type = gravity->get_gravity_type();
-            if (gravity_type == "PoissonGrav" || gravity_type == "MonopoleGrav") {
+            if (gravity_type == "PoissonGrav" || gravity_type == "MonopoleGrav" ||
+                gravity_type == "MultipoleGrav") {
                 total_energy = 0.5 * rho_phi + rho_E;
             }
             else {
@@ -272,45 +261,52 @@ Castro::sum_integrated_quantities ()
             }
 
             i = 0;
-            T_max     = foo_max[i++];
-            rho_max   = foo_max[i++];
-            ts_te_max = foo_max[i++];    // NOLINT(clang-analyzer-deadcode.DeadStores)
-
-            std::cout << '\n';
-            std::cout << "TIME= " << time << " MASS        = "   << mass      << '\n';
-            std::cout << "TIME= " << time << " XMOM        = "   << mom[0]    << '\n';
-            std::cout << "TIME= " << time << " YMOM        = "   << mom[1]    << '\n';
-            std::cout << "TIME= " << time << " ZMOM        = "   << mom[2]    << '\n';
-            std::cout << "TIME= " << time << " ANG MOM X   = "   << ang_mom[0] << '\n';
-            std::cout << "TIME= " << time << " ANG MOM Y   = "   << ang_mom[1] << '\n';
-            std::cout << "TIME= " << time << " ANG MOM Z   = "   << ang_mom[2] << '\n';
+            T_max     = foo_max_sum[i++];
+            rho_max   = foo_max_sum[i++];
+            ts_te_max = foo_max_sum[i++];    // NOLINT(clang-analyzer-deadcode.DeadStores)
+
+            // Build the screen output as a single string so that it
+            // does not get interleaved with output from the main thread.
+
+            std::ostringstream out;
+
+            out << '\n';
+            out << "TIME= " << time << " MASS        = "   << mass      << '\n';
+            out << "TIME= " << time << " XMOM        = "   << mom[0]    << '\n';
+            out << "TIME= " << time << " YMOM        = "   << mom[1]    << '\n';
+            out << "TIME= " << time << " ZMOM        = "   << mom[2]    << '\n';
+            out << "TIME= " << time << " ANG MOM X   = "   << ang_mom[0] << '\n';
+            out << "TIME= " << time << " ANG MOM Y   = "   << ang_mom[1] << '\n';
+            out << "TIME= " << time << " ANG MOM Z   = "   << ang_mom[2] << '\n';
 #ifdef HYBRID_MOMENTUM
-            std::cout << "TIME= " << time << " HYB MOM R   = "   << hyb_mom[0] << '\n';
-            std::cout << "TIME= " << time << " HYB MOM L   = "   << hyb_mom[1] << '\n';
-            std::cout << "TIME= " << time << " HYB MOM P   = "   << hyb_mom[2] << '\n';
+            out << "TIME= " << time << " HYB MOM R   = "   << hyb_mom[0] << '\n';
+            out << "TIME= " << time << " HYB MOM L   = "   << hyb_mom[1] << '\n';
+            out << "TIME= " << time << " HYB MOM P   = "   << hyb_mom[2] << '\n';
 #endif
-            std::cout << "TIME= " << time << " RHO*e       = "   << rho_e     << '\n';
-            std::cout << "TIME= " << time << " RHO*K       = "   << rho_K     << '\n';
-            std::cout << "TIME= " << time << " RHO*E       = "   << rho_E     << '\n';
+            out << "TIME= " << time << " RHO*e       = "   << rho_e     << '\n';
+            out << "TIME= " << time << " RHO*K       = "   << rho_K     << '\n';
+            out << "TIME= " << time << " RHO*E       = "   << rho_E     << '\n';
 #ifdef GRAVITY
-            std::cout << "TIME= " << time << " RHO*PHI     = "   << rho_phi   << '\n';
-            std::cout << "TIME= " << time << " TOTAL ENERGY= "   << total_energy << '\n';
+            out << "TIME= " << time << " RHO*PHI     = "   << rho_phi   << '\n';
+            out << "TIME= " << time << " TOTAL ENERGY= "   << total_energy << '\n';
 #endif
-            std::cout << "TIME= " << time << " CENTER OF MASS X-LOC = " << com[0]     << '\n';
-            std::cout << "TIME= " << time << " CENTER OF MASS X-VEL = " << com_vel[0] << '\n';
+            out << "TIME= " << time << " CENTER OF MASS X-LOC = " << com[0]     << '\n';
+            out << "TIME= " << time << " CENTER OF MASS X-VEL = " << com_vel[0] << '\n';
 
-            std::cout << "TIME= " << time << " CENTER OF MASS Y-LOC = " << com[1]     << '\n';
-            std::cout << "TIME= " << time << " CENTER OF MASS Y-VEL = " << com_vel[1] << '\n';
+            out << "TIME= " << time << " CENTER OF MASS Y-LOC = " << com[1]     << '\n';
+            out << "TIME= " << time << " CENTER OF MASS Y-VEL = " << com_vel[1] << '\n';
 
-            std::cout << "TIME= " << time << " CENTER OF MASS Z-LOC = " << com[2]     << '\n';
-            std::cout << "TIME= " << time << " CENTER OF MASS Z-VEL = " << com_vel[2] << '\n';
+            out << "TIME= " << time << " CENTER OF MASS Z-LOC = " << com[2]     << '\n';
+            out << "TIME= " << time << " CENTER OF MASS Z-VEL = " << com_vel[2] << '\n';
 
-            std::cout << "TIME= " << time << " MAXIMUM TEMPERATURE  = " << T_max << '\n';
-            std::cout << "TIME= " << time << " MAXIMUM DENSITY      = " << rho_max << '\n';
+            out << "TIME= " << time << " MAXIMUM TEMPERATURE  = " << T_max << '\n';
+            out << "TIME= " << time << " MAXIMUM DENSITY      = " << rho_max << '\n';
 #ifdef REACTIONS
-            std::cout << "TIME= " << time << " MAXIMUM T_S / T_E    = " << ts_te_max << '\n';
+            out << "TIME= " << time << " MAXIMUM T_S / T_E    = " << ts_te_max << '\n';
 #endif
 
+            std::cout << out.str() << std::flush;
+
             std::ostream& data_log1 = *Castro::data_logs[0];
 
             if (data_log1.good()) {
@@ -419,10 +415,39 @@ Castro::sum_integrated_quantities ()
                data_log1 << std::endl;
 
             }
-        }
-#ifdef BL_LAZY
-        });
+
+            if (binary_data_logs) {
+
+                std::vector<std::string> names = {"timestep", "time", "mass", "xmom", "ymom", "zmom",
+                                                  "ang_mom_x", "ang_mom_y", "ang_mom_z",
+#ifdef HYBRID_MOMENTUM
+                                                  "hyb_mom_r", "hyb_mom_l", "hyb_mom_p",
+#endif
+                                                  "rho_K", "rho_e", "rho_E",
+#ifdef GRAVITY
+                                                  "rho_phi", "total_energy",
+#endif
+                                                  "com_x", "com_y", "com_z",
+                                                  "com_vel_x", "com_vel_y", "com_vel_z",
+                                                  "T_max", "rho_max", "ts_te_max"};
+
+                std::vector<Real> values = {static_cast<Real>(timestep), time, mass, mom[0], mom[1], mom[2],
+                                            ang_mom[0], ang_mom[1], ang_mom[2],
+#ifdef HYBRID_MOMENTUM
+                                            hyb_mom[0], hyb_mom[1], hyb_mom[2],
+#endif
+                                            rho_K, rho_e, rho_E,
+#ifdef GRAVITY
+                                            rho_phi, total_energy,
 #endif
+                                            com[0], com[1], com[2],
+                                            com_vel[0], com_vel[1], com_vel[2],
+                                            T_max, rho_max, ts_te_max};
+
+                data_log_writer::write_binary_row("grid_diag.bin", names, values);
+
+            }
+        });
     }
 
 #ifdef GRAVITY
@@ -450,28 +475,11 @@ Castro::sum_integrated_quantities ()
 
         }
 
-        const int nfoo_sum = 6;
-
-        amrex::Vector<Real> foo_sum(nfoo_sum);
-
-        foo_sum[0] = h_plus_1;
-        foo_sum[1] = h_cross_1;
-        foo_sum[2] = h_plus_2;
-        foo_sum[3] = h_cross_2;
-        foo_sum[4] = h_plus_3;
-        foo_sum[5] = h_cross_3;
-
-        amrex::ParallelDescriptor::ReduceRealSum(foo_sum.dataPtr(), nfoo_sum);
-
-        h_plus_1   = foo_sum[0];
-        h_cross_1  = foo_sum[1];
-        h_plus_2   = foo_sum[2];
-        h_cross_2  = foo_sum[3];
-        h_plus_3   = foo_sum[4];
-        h_cross_3  = foo_sum[5];
-
-        if (ParallelDescriptor::IOProcessor()) {
+        std::vector<Real> foo_sum = {h_plus_1, h_cross_1, h_plus_2, h_cross_2, h_plus_3, h_cross_3};
 
+        data_log_writer::submit(std::move(foo_sum), {},
+        [=] (const std::vector<Real>& h, const std::vector<Real>& /*unused*/)
+        {
             std::ostream& log = *Castro::data_logs[1];
 
             // Write header row
@@ -522,16 +530,22 @@ Castro::sum_integrated_quantities ()
 
             log << std::scientific;
 
-            log << std::setw(datwidth) << std::setprecision(datprecision) << h_plus_1;
-            log << std::setw(datwidth) << std::setprecision(datprecision) << h_cross_1;
-            log << std::setw(datwidth) << std::setprecision(datprecision) << h_plus_2;
-            log << std::setw(datwidth) << std::setprecision(datprecision) << h_cross_2;
-            log << std::setw(datwidth) << std::setprecision(datprecision) << h_plus_3;
-            log << std::setw(datwidth) << std::setprecision(datprecision) << h_cross_3;
+            for (int i = 0; i < 6; ++i) {
+                log << std::setw(datwidth) << std::setprecision(datprecision) << h[i];
+            }
 
             log << std::endl;
 
-        }
+            if (binary_data_logs) {
+                std::vector<std::string> names = {"timestep", "time",
+                                                  "h_plus_x", "h_cross_x",
+                                                  "h_plus_y", "h_cross_y",
+                                                  "h_plus_z", "h_cross_z"};
+                std::vector<Real> values = {static_cast<Real>(timestep), time};
+                values.insert(values.end(), h.begin(), h.end());
+                data_log_writer::write_binary_row("gravity_diag.bin", names, values);
+            }
+        });
 
     }
 #endif
@@ -559,22 +573,9 @@ Castro::sum_integrated_quantities ()
             }
         }
 
-        int nfoo_sum = NumSpec;
-
-        amrex::Vector<Real> foo_sum(nfoo_sum);
-
-        for (int i = 0; i < NumSpec; ++i) {
-            foo_sum[i] = species_mass[i];
-        }
-
-        amrex::ParallelDescriptor::ReduceRealSum(foo_sum.dataPtr(), nfoo_sum);
-
-        for (int i = 0; i < NumSpec; ++i) {
-            species_mass[i] = foo_sum[i];
-        }
-
-        if (ParallelDescriptor::IOProcessor()) {
-
+        data_log_writer::submit(std::move(species_mass), {},
+        [=] (const std::vector<Real>& foo_sum, const std::vector<Real>& /*unused*/)
+        {
             std::ostream& log = *Castro::data_logs[2];
 
             if (time == 0.0) {
@@ -620,12 +621,21 @@ Castro::sum_integrated_quantities ()
             log << std::scientific;
 
             for (int i = 0; i < NumSpec; i++) {
-                log << std::setw(datwidth) << std::setprecision(datprecision) << species_mass[i];
+                log << std::setw(datwidth) << std::setprecision(datprecision) << foo_sum[i];
             }
 
             log << std::endl;
 
-        }
+            if (binary_data_logs) {
+                std::vector<std::string> names = {"timestep", "time"};
+                for (int i = 0; i < NumSpec; i++) {
+                    names.push_back("mass_" + species_names[i]);
+                }
+                std::vector<Real> values = {static_cast<Real>(timestep), time};
+                values.insert(values.end(), foo_sum.begin(), foo_sum.end());
+                data_log_writer::write_binary_row("species_diag.bin", names, values);
+            }
+        });
 
     }
 
@@ -640,14 +650,14 @@ Castro::sum_integrated_quantities ()
             wall_time = amrex::ParallelDescriptor::second() - wall_time_start;
         }
 
-        // Calculate GPU memory consumption.
+        // Calculate GPU memory consumption. We only have a max reduction
+        // available, so the free memory is negated to get its minimum.
 
-#ifdef AMREX_USE_GPU
-        Long gpu_size_free_MB = Gpu::Device::freeMemAvailable() / (1024 * 1024);
-        ParallelDescriptor::ReduceLongMin(gpu_size_free_MB, ParallelDescriptor::IOProcessorNumber());
+        std::vector<Real> foo_max;
 
-        Long gpu_size_used_MB = (Gpu::Device::totalGlobalMem() - Gpu::Device::freeMemAvailable()) / (1024 * 1024);
-        ParallelDescriptor::ReduceLongMax(gpu_size_used_MB, ParallelDescriptor::IOProcessorNumber());
+#ifdef AMREX_USE_GPU
+        foo_max.push_back(static_cast<Real>((Gpu::Device::totalGlobalMem() - Gpu::Device::freeMemAvailable()) / (1024 * 1024)));
+        foo_max.push_back(-static_cast<Real>(Gpu::Device::freeMemAvailable() / (1024 * 1024)));
 #endif
 
         // Calculate maximum number of advance subcycles across all levels.
@@ -659,7 +669,15 @@ Castro::sum_integrated_quantities ()
             }
         }
 
-        if (ParallelDescriptor::IOProcessor()) {
+        data_log_writer::submit({}, std::move(foo_max),
+        [=] (const std::vector<Real>& /*unused*/, const std::vector<Real>& gpu_mem)
+        {
+#ifdef AMREX_USE_GPU
+            Long gpu_size_used_MB = static_cast<Long>(gpu_mem[0]);
+            Long gpu_size_free_MB = static_cast<Long>(-gpu_mem[1]);
+#else
+            amrex::ignore_unused(gpu_mem);
+#endif
 
             std::ostream& log = *Castro::data_logs[3];
 
@@ -717,7 +735,7 @@ Castro::sum_integrated_quantities ()
             log << std::fixed;
 
             log << std::setw(fixwidth) << std::setprecision(datprecision) << dt;
-            log << std::setw(intwidth)                                    << parent->finestLevel();
+            log << std::setw(intwidth)                                    << finest_level;
             log << std::setw(fixwidth)                                    << max_num_subcycles;
             log << std::setw(datwidth) << std::setprecision(datprecision) << wall_time;
 #ifdef AMREX_USE_GPU
@@ -727,7 +745,15 @@ Castro::sum_integrated_quantities ()
 
             log << std::endl;
 
-        }
+            if (binary_data_logs) {
+                std::vector<std::string> names = {"timestep", "time", "dt", "finest_level",
+                                                  "max_num_subcycles", "wall_time"};
+                std::vector<Real> values = {static_cast<Real>(timestep), time, dt,
+                                            static_cast<Real>(finest_level),
+                                            static_cast<Real>(max_num_subcycles), wall_time};
+                data_log_writer::write_binary_row("amr_diag.bin", names, values);
+            }
+        });
 
     }
 
@@ -28,6 +28,204 @@
 
 using namespace amrex;
 
+namespace {
+
+    // The per-zone pieces of the timestep constraints, shared by the
+    // individual estimators and by estdt_fused().
+
+    // CFL constraint given the sound speed c.
+
+    AMREX_GPU_HOST_DEVICE AMREX_INLINE
+    Real cfl_zone_dt (Array4<Real const> const& u, int i, int j, int k,
+                      Real rhoInv, Real c, GpuArray<Real, AMREX_SPACEDIM> const& dx)
+    {
+        // Compute velocity and then calculate CFL timestep.
+
+        Real ux = u(i,j,k,UMX) * rhoInv;
+#if AMREX_SPACEDIM >= 2
+        Real uy = u(i,j,k,UMY) * rhoInv;
+#endif
+#if AMREX_SPACEDIM == 3
+        Real uz = u(i,j,k,UMZ) * rhoInv;
+#endif
+
+        Real dt1 = dx[0]/(c + std::abs(ux));
+
+        Real dt2;
+#if AMREX_SPACEDIM >= 2
+        dt2 = dx[1]/(c + std::abs(uy));
+#else
+        dt2 = dt1;
+#endif
+
+        Real dt3;
+#if AMREX_SPACEDIM == 3
+        dt3 = dx[2]/(c + std::abs(uz));
+#else
+        dt3 = dt1;
+#endif
+
+        // The CTU method has a less restrictive timestep than MOL-based
+        // schemes (including the true SDC).  Since the simplified SDC
+        // solver is based on CTU, we can use its timestep.
+        if (castro::time_integration_method == 0 || castro::time_integration_method == 3) {
+            return amrex::min(dt1, dt2, dt3);
+
+        } else {
+            // method of lines-style constraint is tougher
+            Real dt_tmp = 1.0_rt/dt1;
+#if AMREX_SPACEDIM >= 2
+            dt_tmp += 1.0_rt/dt2;
+#endif
+#if AMREX_SPACEDIM == 3
+            dt_tmp += 1.0_rt/dt3;
+#endif
+
+            return 1.0_rt/dt_tmp;
+        }
+    }
+
+#ifdef DIFFUSION
+    // Thermal diffusion constraint, dt < 0.5 dx**2 / D, where
+    // D = k/(rho c_v).  eos_state needs to have been through the EOS.
+
+    AMREX_GPU_HOST_DEVICE AMREX_INLINE
+    Real diffusion_zone_dt (eos_t& eos_state, Real rho_inv, GpuArray<Real, AMREX_SPACEDIM> const& dx)
+    {
+        // we also need the conductivity
+        conductivity(eos_state);
+
+        // maybe we should check (and take action) on negative cv here?
+        Real D = eos_state.conductivity * rho_inv / eos_state.cv;
+
+        Real dt1 = 0.5_rt * dx[0]*dx[0] / D;
+
+        Real dt2;
+#if AMREX_SPACEDIM >= 2
+        dt2 = 0.5_rt * dx[1]*dx[1] / D;
+#else
+        dt2 = dt1;
+#endif
+
+        Real dt3;
+#if AMREX_SPACEDIM >= 3
+        dt3 = 0.5_rt * dx[2]*dx[2] / D;
+#else
+        dt3 = dt1;
+#endif
+
+        return amrex::min(dt1, dt2, dt3);
+    }
+#endif
+
+#ifdef REACTIONS
+    // Burning constraint.  burn_state needs to hold the zone's
+    // thermodynamic state (after an EOS call) and e is the zone's
+    // specific internal energy.
+
+    AMREX_GPU_HOST_DEVICE AMREX_INLINE
+    Real burning_zone_dt (burn_t& burn_state, Real e,
+                          [[maybe_unused]] Array4<Real const> const& S,
+                          [[maybe_unused]] int i, [[maybe_unused]] int j, [[maybe_unused]] int k)
+    {
+        // Set a floor on the minimum size of a derivative. This floor
+        // is small enough such that it will result in no timestep limiting.
+
+        const Real derivative_floor = 1.e-50_rt;
+
+        // We want to limit the timestep so that it is not larger than
+        // dtnuc_e * (e / (de/dt)).  If the timestep factor dtnuc is
+        // equal to 1, this says that we don't want the
+        // internal energy to change by any more than its current
+        // magnitude in the next timestep.
+        //
+        // If dtnuc is less than one, it controls the fraction we will
+        // allow the internal energy to change in this timestep due to
+        //  nuclear burning, provided that our instantaneous estimate
+        // of the energy release is representative of the full timestep.
+        //
+        // We also do the same thing for the species, using a timestep
+        // limiter dtnuc_X * (X_k / (dX_k/dt)). To prevent changes
+        // due to trace isotopes that we probably are not interested in,
+        // only apply the limiter to species with an abundance greater
+        // than a user-specified threshold.
+
+        Real X[NumSpec];
+        for (int n = 0; n < NumSpec; ++n) {
+            X[n] = amrex::max(burn_state.xn[n], small_x);
+        }
+
+        Array1D<Real, 1, neqs> ydot;
+        actual_rhs(burn_state, ydot);
+
+        Real dedt = ydot(net_ienuc);
+        Real dXdt[NumSpec];
+        for (int n = 0; n < NumSpec; ++n) {
+            dXdt[n] = ydot(n+1) * aion[n];
+        }
+
+        // Apply a floor to the derivatives. This ensures that we don't
+        // divide by zero; it also gives us a quick method to disable
+        // the timestep limiting, because the floor is small enough
+        // that the implied timestep will be very large, and thus
+        // ignored compared to other limiters.
+
+        dedt = amrex::max(std::abs(dedt), derivative_floor);
+
+        for (int n = 0; n < NumSpec; ++n) {
+            if (X[n] >= castro::dtnuc_X_threshold) {
+                dXdt[n] = amrex::max(std::abs(dXdt[n]), derivative_floor);
+            } else {
+                dXdt[n] = derivative_floor;
+            }
+        }
+
+        Real dt_tmp = 1.e200_rt;
+
+#ifdef NSE
+
+#ifdef SIMPLIFIED_SDC
+        // if we are doing simplified-SDC + NSE, then the `in_nse()`
+        // check will use burn_state.y[], so we need to ensure that
+        // those are initialized
+        for (int n = 0; n < NumSpec; ++n) {
+            burn_state.y[SFS+n] = burn_state.rho * burn_state.xn[n];
+        }
+
+        burn_state.y[SEINT] = burn_state.rho * burn_state.e;
+
+#endif
+
+#ifdef NSE_NET
+        burn_state.mu_p = S(i,j,k,UMUP);
+        burn_state.mu_n = S(i,j,k,UMUN);
+#endif
+
+        if (!in_nse(burn_state)) {
+#endif
+            dt_tmp = castro::dtnuc_e * e / dedt;
+#ifdef NSE
+        }
+#endif
+        for (int n = 0; n < NumSpec; ++n) {
+            dt_tmp = amrex::min(dt_tmp, castro::dtnuc_X * (X[n] / dXdt[n]));
+        }
+
+        return dt_tmp;
+    }
+
+    // Is this zone outside of the range where we burn?
+
+    AMREX_GPU_HOST_DEVICE AMREX_INLINE
+    bool outside_burning_range (Real rho, Real T)
+    {
+        return T < castro::react_T_min || T > castro::react_T_max ||
+               rho < castro::react_rho_min || rho > castro::react_rho_max;
+    }
+#endif
+
+}
+
 ValLocPair<Real, IntVect>
 Castro::estdt_cfl (int is_new)
 {
@@ -65,53 +263,7 @@ Castro::estdt_cfl (int is_new)
 
       eos(eos_input_re, eos_state);
 
-      // Compute velocity and then calculate CFL timestep.
-
-      Real ux = u(i,j,k,UMX) * rhoInv;
-#if AMREX_SPACEDIM >= 2
-      Real uy = u(i,j,k,UMY) * rhoInv;
-#endif
-#if AMREX_SPACEDIM == 3
-      Real uz = u(i,j,k,UMZ) * rhoInv;
-#endif
-
-      Real c = eos_state.cs;
-
-      Real dt1 = dx[0]/(c + std::abs(ux));
-
-      Real dt2;
-#if AMREX_SPACEDIM >= 2
-      dt2 = dx[1]/(c + std::abs(uy));
-#else
-      dt2 = dt1;
-#endif
-
-      Real dt3;
-#if AMREX_SPACEDIM == 3
-      dt3 = dx[2]/(c + std::abs(uz));
-#else
-      dt3 = dt1;
-#endif
-
-      // The CTU method has a less restrictive timestep than MOL-based
-      // schemes (including the true SDC).  Since the simplified SDC
-      // solver is based on CTU, we can use its timestep.
-      if (castro::time_integration_method == 0 || castro::time_integration_method == 3) {
-          Real dt = amrex::min(dt1, dt2, dt3);
-          return {ValLocPair<Real, IntVect>{dt, idx}};
-
-      } else {
-          // method of lines-style constraint is tougher
-          Real dt_tmp = 1.0_rt/dt1;
-#if AMREX_SPACEDIM >= 2
-          dt_tmp += 1.0_rt/dt2;
-#endif
-#if AMREX_SPACEDIM == 3
-          dt_tmp += 1.0_rt/dt3;
-#endif
-
-          return {ValLocPair<Real, IntVect>{1.0_rt/dt_tmp, idx}};
-      }
+      return {ValLocPair<Real, IntVect>{cfl_zone_dt(u, i, j, k, rhoInv, eos_state.cs, dx), idx}};
 
   });
 
@@ -226,238 +378,93 @@ Castro::estdt_mhd (int is_new)
 }
 #endif
 
-#ifdef DIFFUSION
-
-ValLocPair<Real, IntVect>
-Castro::estdt_temp_diffusion (int is_new)
+Array<ValLocPair<Real, IntVect>, num_dt_constraints>
+Castro::estdt_fused (int is_new,
+                     [[maybe_unused]] bool do_cfl,
+                     [[maybe_unused]] bool do_diffusion,
+                     [[maybe_unused]] bool do_burning)
 {
+    BL_PROFILE("Castro::estdt_fused()");
 
-  // Diffusion-limited timestep
-  //
-  // dt < 0.5 dx**2 / D
-  // where D = k/(rho c_v), and k is the conductivity
-
-  const auto dx = geom.CellSizeArray();
-
-  const MultiFab& stateMF = is_new ? get_new_data(State_Type) : get_old_data(State_Type);
-
-  const Real ldiffuse_cutoff_density = diffuse_cutoff_density;
-  const Real lmax_dt = max_dt;
-  const Real lcfl = cfl;
-
-  auto const& ua = stateMF.const_arrays();
-
-  auto r = amrex::ParReduce(TypeList<ReduceOpMin>{}, TypeList<ValLocPair<Real, IntVect>>{}, stateMF,
-  [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) -> GpuTuple<ValLocPair<Real, IntVect>>
-  {
-
-      Array4<Real const> const& ustate = ua[box_no];
-
-      IntVect idx(AMREX_D_DECL(i,j,k));
-
-      if (ustate(i,j,k,URHO) > ldiffuse_cutoff_density) {
-
-          Real rho_inv = 1.0_rt/ustate(i,j,k,URHO);
-
-          // we need cv
-          eos_t eos_state;
-
-          eos_state.rho = ustate(i,j,k,URHO);
-          eos_state.T = ustate(i,j,k,UTEMP);
-          eos_state.e = ustate(i,j,k,UEINT) * rho_inv;
-          for (int n = 0; n < NumSpec; n++) {
-              eos_state.xn[n]  = ustate(i,j,k,UFS+n) * rho_inv;
-          }
-#if NAUX_NET > 0
-          for (int n = 0; n < NumAux; n++) {
-              eos_state.aux[n] = ustate(i,j,k,UFX+n) * rho_inv;
-          }
-#endif
-
-          eos(eos_input_re, eos_state);
+    // All of the constraints that need the thermodynamic state are
+    // evaluated from a single (rho, e) EOS call per zone. The burning
+    // constraint uses the result of that call rather than a separate
+    // (rho, T) call.
 
-          // we also need the conductivity
-          conductivity(eos_state);
-
-          // maybe we should check (and take action) on negative cv here?
-          Real D = eos_state.conductivity * rho_inv / eos_state.cv;
-
-          Real dt1 = 0.5_rt * dx[0]*dx[0] / D;
-
-          Real dt2;
-#if AMREX_SPACEDIM >= 2
-          dt2 = 0.5_rt * dx[1]*dx[1] / D;
-#else
-          dt2 = dt1;
-#endif
-
-          Real dt3;
-#if AMREX_SPACEDIM >= 3
-          dt3 = 0.5_rt * dx[2]*dx[2] / D;
-#else
-          dt3 = dt1;
-#endif
-
-          return {ValLocPair<Real, IntVect>{amrex::min(dt1, dt2, dt3), idx}};
+    const auto dx = geom.CellSizeArray();
 
-      } else {
-          return {ValLocPair<Real, IntVect>{lmax_dt/lcfl, idx}};
-      }
-  });
+    const MultiFab& stateMF = is_new ? get_new_data(State_Type) : get_old_data(State_Type);
 
-  return r;
-}
+#ifdef DIFFUSION
+    const Real ldiffuse_cutoff_density = diffuse_cutoff_density;
 #endif
 
-#ifdef REACTIONS
-ValLocPair<Real, IntVect>
-Castro::estdt_burning (int is_new)
-{
-
-    if (castro::dtnuc_e > 1.e199_rt && castro::dtnuc_X > 1.e199_rt) {
-        IntVect idx(AMREX_D_DECL(0,0,0));
-        return {ValLocPair<Real, IntVect>{1.e200_rt, idx}};
-    }
-
-    const auto dx = geom.CellSizeArray();
-
-    MultiFab& stateMF = is_new ? get_new_data(State_Type) : get_old_data(State_Type);
-
     auto const& ua = stateMF.const_arrays();
 
-    auto r = amrex::ParReduce(TypeList<ReduceOpMin>{}, TypeList<ValLocPair<Real, IntVect>>{}, stateMF,
-    [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) -> GpuTuple<ValLocPair<Real, IntVect>>
+    using VLP = ValLocPair<Real, IntVect>;
+
+    auto r = amrex::ParReduce(TypeList<ReduceOpMin, ReduceOpMin, ReduceOpMin>{},
+                              TypeList<VLP, VLP, VLP>{}, stateMF,
+    [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) -> GpuTuple<VLP, VLP, VLP>
     {
 
-        Array4<Real const> const& S = ua[box_no];
+        Array4<Real const> const& u = ua[box_no];
 
         IntVect idx(AMREX_D_DECL(i,j,k));
 
-        // Set a floor on the minimum size of a derivative. This floor
-        // is small enough such that it will result in no timestep limiting.
-
-        const Real derivative_floor = 1.e-50_rt;
-
-        // We want to limit the timestep so that it is not larger than
-        // dtnuc_e * (e / (de/dt)).  If the timestep factor dtnuc is
-        // equal to 1, this says that we don't want the
-        // internal energy to change by any more than its current
-        // magnitude in the next timestep.
-        //
-        // If dtnuc is less than one, it controls the fraction we will
-        // allow the internal energy to change in this timestep due to
-        //  nuclear burning, provided that our instantaneous estimate
-        // of the energy release is representative of the full timestep.
-        //
-        // We also do the same thing for the species, using a timestep
-        // limiter dtnuc_X * (X_k / (dX_k/dt)). To prevent changes
-        // due to trace isotopes that we probably are not interested in,
-        // only apply the limiter to species with an abundance greater
-        // than a user-specified threshold.
-        //
-        // To estimate de/dt and dX/dt, we are going to call the RHS of the
-        // burner given the current state data. We need to do an EOS
-        // call before we do the RHS call so that we have accurate
-        // values for the thermodynamic data like abar, zbar, etc.
-        // But we will call in (rho, T) mode, which is inexpensive.
-
-        Real rhoInv = 1.0_rt / S(i,j,k,URHO);
-
-        burn_t burn_state;
-
-#if AMREX_SPACEDIM == 1
-        burn_state.dx = dx[0];
-#else
-        burn_state.dx = amrex::min(AMREX_D_DECL(dx[0], dx[1], dx[2]));
-#endif
+        Real rhoInv = 1.0_rt / u(i,j,k,URHO);
 
-        burn_state.rho = S(i,j,k,URHO);
-        burn_state.T   = S(i,j,k,UTEMP);
-        burn_state.e   = S(i,j,k,UEINT) * rhoInv;
-        for (int n = 0; n < NumSpec; ++n) {
-            burn_state.xn[n] = S(i,j,k,UFS+n) * rhoInv;
+        eos_t eos_state;
+        eos_state.rho = u(i,j,k,URHO);
+        eos_state.T = u(i,j,k,UTEMP);
+        eos_state.e = u(i,j,k,UEINT) * rhoInv;
+        for (int n = 0; n < NumSpec; n++) {
+            eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
         }
 #if NAUX_NET > 0
-        for (int n = 0; n < NumAux; ++n) {
-            burn_state.aux[n] = S(i,j,k,UFX+n) * rhoInv;
+        for (int n = 0; n < NumAux; n++) {
+            eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
         }
 #endif
 
-        if (burn_state.T < castro::react_T_min || burn_state.T > castro::react_T_max ||
-            burn_state.rho < castro::react_rho_min || burn_state.rho > castro::react_rho_max) {
-            return {ValLocPair<Real, IntVect>{1.e200_rt, idx}};
-        }
-
-        Real e = burn_state.e;
-        Real X[NumSpec];
-        for (int n = 0; n < NumSpec; ++n) {
-            X[n] = amrex::max(burn_state.xn[n], small_x);
-        }
+        eos(eos_input_re, eos_state);
 
-        eos(eos_input_rt, burn_state);
+        Real dt_cfl = 1.e200_rt;
+        Real dt_diffusion = 1.e200_rt;
+        Real dt_burning = 1.e200_rt;
 
-        Array1D<Real, 1, neqs> ydot;
-        actual_rhs(burn_state, ydot);
-
-        Real dedt = ydot(net_ienuc);
-        Real dXdt[NumSpec];
-        for (int n = 0; n < NumSpec; ++n) {
-            dXdt[n] = ydot(n+1) * aion[n];
+        if (do_cfl) {
+            dt_cfl = cfl_zone_dt(u, i, j, k, rhoInv, eos_state.cs, dx);
         }
 
-        // Apply a floor to the derivatives. This ensures that we don't
-        // divide by zero; it also gives us a quick method to disable
-        // the timestep limiting, because the floor is small enough
-        // that the implied timestep will be very large, and thus
-        // ignored compared to other limiters.
-
-        dedt = amrex::max(std::abs(dedt), derivative_floor);
-
-        for (int n = 0; n < NumSpec; ++n) {
-            if (X[n] >= castro::dtnuc_X_threshold) {
-                dXdt[n] = amrex::max(std::abs(dXdt[n]), derivative_floor);
-            } else {
-                dXdt[n] = derivative_floor;
-            }
+#ifdef DIFFUSION
+        if (do_diffusion && u(i,j,k,URHO) > ldiffuse_cutoff_density) {
+            dt_diffusion = diffusion_zone_dt(eos_state, rhoInv, dx);
         }
+#endif
 
-        Real dt_tmp = 1.e200_rt;
-
-#ifdef NSE
-
-#ifdef SIMPLIFIED_SDC
-        // if we are doing simplified-SDC + NSE, then the `in_nse()`
-        // check will use burn_state.y[], so we need to ensure that
-        // those are initialized
-        for (int n = 0; n < NumSpec; ++n) {
-            burn_state.y[SFS+n] = burn_state.rho * burn_state.xn[n];
-        }
+#ifdef REACTIONS
+        if (do_burning && !outside_burning_range(u(i,j,k,URHO), u(i,j,k,UTEMP))) {
 
-        burn_state.y[SEINT] = burn_state.rho * burn_state.e;
+            burn_t burn_state;
 
-#endif
+            eos_to_burn(eos_state, burn_state);
 
-#ifdef NSE_NET
-        burn_state.mu_p = S(i,j,k,UMUP);
-        burn_state.mu_n = S(i,j,k,UMUN);
+#if AMREX_SPACEDIM == 1
+            burn_state.dx = dx[0];
+#else
+            burn_state.dx = amrex::min(AMREX_D_DECL(dx[0], dx[1], dx[2]));
 #endif
 
-        if (!in_nse(burn_state)) {
-#endif
-            dt_tmp = dtnuc_e * e / dedt;
-#ifdef NSE
+            dt_burning = burning_zone_dt(burn_state, u(i,j,k,UEINT) * rhoInv, u, i, j, k);
         }
 #endif
-        for (int n = 0; n < NumSpec; ++n) {
-            dt_tmp = amrex::min(dt_tmp, dtnuc_X * (X[n] / dXdt[n]));
-        }
 
-        return {ValLocPair<Real, IntVect>{dt_tmp, idx}};
+        return {VLP{dt_cfl, idx}, VLP{dt_diffusion, idx}, VLP{dt_burning, idx}};
     });
 
-    return r;
+    return {amrex::get<cfl_dt>(r), amrex::get<diffusion_dt>(r), amrex::get<burning_dt>(r)};
 }
-#endif
 
 #ifdef RADIATION
 Real
@@ -173,23 +173,20 @@ Castro::construct_new_gravity (Real time)
                 amrex::Print() << "\n... new-time composite Poisson gravity solve from level " << level << " to level " << parent->finestLevel() << std::endl << std::endl;
             }
 
-            // Use the "old" phi from the current time step as a guess for this solve.
+            // Use the "old" phi from the current time step (optionally
+            // extrapolated forward in time) as a guess for this solve.
 
             for (int lev = level; lev <= parent->finestLevel(); ++lev) {
-                MultiFab& lev_phi_old = getLevel(lev).get_old_data(PhiGrav_Type);
-                MultiFab& lev_phi_new = getLevel(lev).get_new_data(PhiGrav_Type);
-
-                MultiFab::Copy(lev_phi_new, lev_phi_old, 0, 0, 1, lev_phi_new.nGrow());
+                gravity->make_new_phi_guess(lev);
             }
 
             gravity->multilevel_solve_for_new_phi(level, parent->finestLevel());
         }
         else if (parent->subcyclingMode() != "None") {
-            // Use the "old" phi from the current time step as a guess for this solve.
-
-            MultiFab& phi_old = get_old_data(PhiGrav_Type);
+            // Use the "old" phi from the current time step (optionally
+            // extrapolated forward in time) as a guess for this solve.
 
-            MultiFab::Copy(phi_new, phi_old, 0, 0, 1, phi_new.nGrow());
+            gravity->make_new_phi_guess(level);
 
             // Subtract off the (composite - level) contribution for the purposes
             // of the level solve. We'll add it back later.
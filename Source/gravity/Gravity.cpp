@@ -28,6 +28,8 @@ int Gravity::test_solves  = 1;
 int Gravity::test_solves  = 0;
 #endif
 Real Gravity::mass_offset    =  0.0;
+Long Gravity::num_syncs_solved  = 0;
+Long Gravity::num_syncs_skipped = 0;
 
 // ************************************************************************************** //
 
@@ -60,6 +62,65 @@ AMREX_GPU_MANAGED Array2D<Real, 0, multipole::lnum_max, 0, multipole::lnum_max>
 AMREX_GPU_MANAGED Array1D<Real, 0, multipole::lnum_max> multipole::parity_q0;
 AMREX_GPU_MANAGED Array2D<Real, 0, multipole::lnum_max, 0, multipole::lnum_max> multipole::parity_qC_qS;
 
+namespace {
+
+    // A sum over all ranks of a buffer of boundary data, done as one
+    // non-blocking collective so that the caller can overlap other
+    // work with it. If MPI can't read device memory we stage the data
+    // through a pinned host buffer.
+
+    class BufferReduction
+    {
+    public:
+
+        void start (Real* data, Long n)
+        {
+            // because the number of elements in mpi_reduce is int
+            AMREX_ALWAYS_ASSERT(n <= std::numeric_limits<int>::max());
+
+            m_data = data;
+            m_comm_data = data;
+
+            Gpu::streamSynchronize();
+
+#ifdef AMREX_USE_GPU
+            if (!ParallelDescriptor::UseGpuAwareMpi()) {
+                m_host.resize(n);
+                Gpu::copy(Gpu::deviceToHost, data, data + n, m_host.begin());
+                m_comm_data = m_host.data();
+            }
+#endif
+
+#ifdef BL_USE_MPI
+            MPI_Iallreduce(MPI_IN_PLACE, m_comm_data, static_cast<int>(n),
+                           ParallelDescriptor::Mpi_typemap<Real>::type(), MPI_SUM,
+                           ParallelDescriptor::Communicator(), &m_request);
+#endif
+        }
+
+        void finish ()
+        {
+#ifdef BL_USE_MPI
+            MPI_Wait(&m_request, MPI_STATUS_IGNORE);
+#endif
+
+            if (m_comm_data != m_data) {
+                Gpu::copy(Gpu::hostToDevice, m_host.begin(), m_host.end(), m_data);
+            }
+        }
+
+    private:
+
+        Real* m_data = nullptr;
+        Real* m_comm_data = nullptr;
+        Gpu::PinnedVector<Real> m_host;
+#ifdef BL_USE_MPI
+        MPI_Request m_request = MPI_REQUEST_NULL;
+#endif
+    };
+
+}
+
 Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _density)
   :
     parent(Parent),
@@ -73,7 +134,9 @@ Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _density)
     level_solver_resnorm(MAX_LEV),
     volume(MAX_LEV),
     area(MAX_LEV),
-    phys_bc(_phys_bc)
+    phys_bc(_phys_bc),
+    phi_prev(MAX_LEV),
+    phi_prev_time(MAX_LEV, 0.0)
 {
 
      amrex::ignore_unused(_finest_level);
@@ -96,6 +159,16 @@ Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _density)
          make_mg_bc();
          init_multipole_grav();
      }
+     else if (gravity::gravity_type == "MultipoleGrav") {
+         init_multipole_grav();
+
+         // The shell expansion does not include the image mass across a
+         // symmetry plane that the center is not on.
+
+         if (multipole::doSymmetricAdd) {
+             amrex::Abort("MultipoleGrav requires the center to lie on any symmetry boundaries");
+         }
+     }
      max_rhs = 0.0;
      numpts_at_level = -1;
 }
@@ -115,12 +188,18 @@ Gravity::read_params ()
 
         if ( (gravity::gravity_type != "ConstantGrav") &&
              (gravity::gravity_type != "PoissonGrav") &&
-             (gravity::gravity_type != "MonopoleGrav") )
+             (gravity::gravity_type != "MonopoleGrav") &&
+             (gravity::gravity_type != "MultipoleGrav") )
              {
                 std::cout << "Sorry -- dont know this gravity type"  << std::endl;
-                amrex::Abort("Options are ConstantGrav, PoissonGrav, or MonopoleGrav");
+                amrex::Abort("Options are ConstantGrav, PoissonGrav, MonopoleGrav, or MultipoleGrav");
              }
 
+        if (gravity::gravity_type == "MultipoleGrav" && dgeom.isAnyPeriodic())
+        {
+          amrex::Abort("MultipoleGrav cannot be used with periodic boundaries");
+        }
+
         if (  gravity::gravity_type == "ConstantGrav")
         {
           if ( dgeom.IsSPHERICAL() ) {
@@ -137,6 +216,10 @@ Gravity::read_params ()
         {
           amrex::Abort("Only use MonopoleGrav in 1D spherical coordinates");
         }
+        else if (gravity::gravity_type == "MultipoleGrav")
+        {
+          amrex::Abort(" gravity::gravity_type = MultipoleGrav is the same as MonopoleGrav in 1-d -- please set gravity::gravity_type = MonopoleGrav");
+        }
         else if (gravity::gravity_type == "ConstantGrav" && dgeom.IsSPHERICAL())
         {
           amrex::Abort("Can't use constant gravity in 1D spherical coordinates");
@@ -147,6 +230,10 @@ Gravity::read_params ()
         {
           amrex::Abort(" gravity::gravity_type = MonopoleGrav doesn't make sense in 2D Cartesian coordinates");
         }
+        else if (gravity::gravity_type == "MultipoleGrav" && !(dgeom.IsRZ()) )
+        {
+          amrex::Abort(" gravity::gravity_type = MultipoleGrav requires 2D axisymmetric coordinates");
+        }
 #endif
 
         if (pp.contains("get_g_from_phi") && !gravity::get_g_from_phi && gravity::gravity_type == "PoissonGrav") {
@@ -299,6 +386,9 @@ Gravity::install_level (int                   level,
 
     level_solver_resnorm[level] = 0.0;
 
+    clear_mlpoisson_cache();
+    sync_prev_delta_phi.clear();
+
     const Geometry& geom = level_data->Geom();
 
     if (gravity::gravity_type == "PoissonGrav") {
@@ -334,6 +424,60 @@ Gravity::install_level (int                   level,
     finest_level_allocated = level;
 }
 
+void
+Gravity::clear_mlpoisson_cache ()
+{
+    mlpoisson_cache.clear();
+}
+
+void
+Gravity::make_new_phi_guess (int level)
+{
+    BL_PROFILE("Gravity::make_new_phi_guess()");
+
+    const StateData& phi_state = LevelData[level]->get_state_data(PhiGrav_Type);
+
+    const MultiFab& phi_old = phi_state.oldData();
+    MultiFab& phi_new = LevelData[level]->get_new_data(PhiGrav_Type);
+
+    const Real t_old = phi_state.prevTime();
+    const Real t_new = phi_state.curTime();
+
+    MultiFab::Copy(phi_new, phi_old, 0, 0, 1, phi_new.nGrow());
+
+    if (!gravity::mlmg_extrapolate_guess) {
+        return;
+    }
+
+    // The previous step's old-time phi is only usable if the grids have not
+    // changed since then and it really is from an earlier time (it is not,
+    // for example, if this step is being retried).
+
+    const bool same_grids = phi_prev[level] != nullptr &&
+                            phi_prev[level]->boxArray() == phi_old.boxArray() &&
+                            phi_prev[level]->DistributionMap() == phi_old.DistributionMap() &&
+                            phi_prev[level]->nGrow() == phi_new.nGrow();
+
+    if (same_grids && phi_prev_time[level] < t_old) {
+
+        // phi_guess = phi_old + (t_new - t_old) * (phi_old - phi_prev) / (t_old - t_prev)
+
+        const Real w = (t_new - t_old) / (t_old - phi_prev_time[level]);
+
+        MultiFab::LinComb(phi_new, 1.0_rt + w, phi_old, 0, -w, *phi_prev[level], 0, 0, 1, phi_new.nGrow());
+
+    }
+
+    if (!same_grids) {
+        phi_prev[level] = std::make_unique<MultiFab>(phi_old.boxArray(), phi_old.DistributionMap(), 1, phi_new.nGrow());
+    }
+
+    // Remember the old-time phi for the next step.
+
+    MultiFab::Copy(*phi_prev[level], phi_old, 0, 0, 1, phi_new.nGrow());
+    phi_prev_time[level] = t_old;
+}
+
 std::string Gravity::get_gravity_type()
 {
   return gravity::gravity_type;
@@ -497,29 +641,6 @@ Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>&
 
     int nlevs = fine_level - crse_level + 1;
 
-    // Construct delta(phi) and delta(grad_phi). delta(phi)
-    // needs a ghost zone for holding the boundary condition
-    // in the same way that phi does.
-
-    Vector<std::unique_ptr<MultiFab> > delta_phi(nlevs);
-
-    for (int lev = crse_level; lev <= fine_level; ++lev) {
-        delta_phi[lev - crse_level] = std::make_unique<MultiFab>(grids[lev], dmap[lev], 1, 1);
-        delta_phi[lev - crse_level]->setVal(0.0);
-    }
-
-    Vector< Vector<std::unique_ptr<MultiFab> > > ec_gdPhi(nlevs);
-
-    for (int lev = crse_level; lev <= fine_level; ++lev) {
-        ec_gdPhi[lev - crse_level].resize(AMREX_SPACEDIM);
-
-        const DistributionMapping& dm = LevelData[lev]->DistributionMap();
-        for (int n = 0; n < AMREX_SPACEDIM; ++n) {
-            ec_gdPhi[lev - crse_level][n] = std::make_unique<MultiFab>(LevelData[lev]->getEdgeBoxArray(n), dm, 1, 0);
-            ec_gdPhi[lev - crse_level][n]->setVal(0.0);
-        }
-    }
-
     // Construct a container for the right-hand-side (4 * pi * G * drho + dphi).
     // dphi appears in the construction of the boundary conditions because it
     // indirectly represents a change in mass on the domain (the mass motion that
@@ -538,91 +659,187 @@ Gravity::gravity_sync (int crse_level, int fine_level, const Vector<MultiFab*>&
         MultiFab::Add(*rhs[lev - crse_level], *drho[lev - crse_level], 0, 0, 1, 0);
     }
 
-    // Construct the boundary conditions for the Poisson solve.
+    // If the reflux barely changed the RHS, the correction to phi would be
+    // negligible, so we skip the solve (and the boundary conditions for it).
+    // We still average phi and g down at the end, as the solve would.
+
+    bool skip_solve = false;
+
+    if (gravity::sync_skip_tol > 0.0_rt) {
+        Real rhs_norm = 0.0_rt;
+        for (int lev = crse_level; lev <= fine_level; ++lev) {
+            rhs_norm = amrex::max(rhs_norm, rhs[lev - crse_level]->norm0(0, 0, true));
+        }
+        ParallelDescriptor::ReduceRealMax(rhs_norm);
 
-    if (crse_level == 0 && !crse_geom.isAllPeriodic()) {
+        skip_solve = Ggravity * rhs_norm < gravity::sync_skip_tol * max_rhs;
 
         if (gravity::verbose > 1) {
-            amrex::Print() << " ... Making bc's for delta_phi at crse_level 0"  << std::endl;
+            amrex::Print() << " ... gravity_sync RHS norm relative to max_rhs = "
+                           << Ggravity * rhs_norm / amrex::max(max_rhs, std::numeric_limits<Real>::min())
+                           << (skip_solve ? " : skipping the solve" : "") << '\n';
         }
+    }
+
+    if (skip_solve) {
+        ++num_syncs_skipped;
+    } else {
+        ++num_syncs_solved;
+
+        // Construct delta(phi) and delta(grad_phi). delta(phi)
+        // needs a ghost zone for holding the boundary condition
+        // in the same way that phi does.
+
+        Vector<std::unique_ptr<MultiFab> > delta_phi(nlevs);
+
+        for (int lev = crse_level; lev <= fine_level; ++lev) {
+            delta_phi[lev - crse_level] = std::make_unique<MultiFab>(grids[lev], dmap[lev], 1, 1);
+            delta_phi[lev - crse_level]->setVal(0.0);
+        }
+
+        Vector< Vector<std::unique_ptr<MultiFab> > > ec_gdPhi(nlevs);
+
+        for (int lev = crse_level; lev <= fine_level; ++lev) {
+            ec_gdPhi[lev - crse_level].resize(AMREX_SPACEDIM);
+
+            const DistributionMapping& dm = LevelData[lev]->DistributionMap();
+            for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+                ec_gdPhi[lev - crse_level][n] = std::make_unique<MultiFab>(LevelData[lev]->getEdgeBoxArray(n), dm, 1, 0);
+                ec_gdPhi[lev - crse_level][n]->setVal(0.0);
+            }
+        }
+
+        // Restoring the factor of (4 * pi * G) for the Poisson solve is
+        // independent of the boundary values, so where we construct them
+        // it is done while their global reduction is in flight.
+
+        auto scale_rhs = [&] ()
+        {
+            for (int lev = crse_level; lev <= fine_level; ++lev)
+                rhs[lev - crse_level]->mult(Ggravity);
+        };
+
+        // Construct the boundary conditions for the Poisson solve.
+
+        if (crse_level == 0 && !crse_geom.isAllPeriodic()) {
+
+            if (gravity::verbose > 1) {
+                amrex::Print() << " ... Making bc's for delta_phi at crse_level 0"  << std::endl;
+            }
 
 #if (AMREX_SPACEDIM == 3)
-      if ( gravity::direct_sum_bcs )
-          fill_direct_sum_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
-      else {
-          fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
-      }
+          if ( gravity::direct_sum_bcs )
+              fill_direct_sum_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level],scale_rhs);
+          else {
+              fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level],scale_rhs);
+          }
 #elif (AMREX_SPACEDIM == 2)
-      fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+          fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level],scale_rhs);
 #else
-      fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level]);
+          fill_multipole_BCs(crse_level,fine_level,amrex::GetVecOfPtrs(rhs),*delta_phi[crse_level],scale_rhs);
 #endif
 
-    }
+        }
+        else {
+            scale_rhs();
+        }
 
-    // Restore the factor of (4 * pi * G) for the Poisson solve.
-    for (int lev = crse_level; lev <= fine_level; ++lev)
-        rhs[lev - crse_level]->mult(Ggravity);
+        // In the all-periodic case we enforce that the RHS sums to zero.
+        // We only do this if we're periodic and the coarse level covers the whole domain.
+        // In principle this could be true for level > 0, so we'll test on whether the number
+        // of points on the level is equal to the number of points possible on the level.
+        // Note that since we did the average-down, we can stick with the data on the coarse
+        // level since the averaging down is conservative.
 
-    // In the all-periodic case we enforce that the RHS sums to zero.
-    // We only do this if we're periodic and the coarse level covers the whole domain.
-    // In principle this could be true for level > 0, so we'll test on whether the number
-    // of points on the level is equal to the number of points possible on the level.
-    // Note that since we did the average-down, we can stick with the data on the coarse
-    // level since the averaging down is conservative.
+        if (crse_geom.isAllPeriodic() && (grids[crse_level].numPts() == crse_domain.numPts()))
+        {
 
-    if (crse_geom.isAllPeriodic() && (grids[crse_level].numPts() == crse_domain.numPts()))
-    {
+            // We assume that if we're fully periodic then we're going to be in Cartesian
+            // coordinates, so to get the average value of the RHS we can divide the sum
+            // of the RHS by the number of points. This correction should probably be
+            // volume weighted if we somehow got here without being Cartesian.
 
-        // We assume that if we're fully periodic then we're going to be in Cartesian
-        // coordinates, so to get the average value of the RHS we can divide the sum
-        // of the RHS by the number of points. This correction should probably be
-        // volume weighted if we somehow got here without being Cartesian.
+            Real local_correction = rhs[0]->sum() / static_cast<Real>(grids[crse_level].numPts());
 
-        Real local_correction = rhs[0]->sum() / static_cast<Real>(grids[crse_level].numPts());
+            if (gravity::verbose > 1) {
+                amrex::Print() << "WARNING: Adjusting RHS in gravity_sync solve by " << local_correction << '\n';
+            }
 
-        if (gravity::verbose > 1) {
-            amrex::Print() << "WARNING: Adjusting RHS in gravity_sync solve by " << local_correction << '\n';
+            for (int lev = fine_level; lev >= crse_level; --lev) {
+                rhs[lev-crse_level]->plus(-local_correction, 0, 1, 0);
+            }
         }
 
-        for (int lev = fine_level; lev >= crse_level; --lev) {
-            rhs[lev-crse_level]->plus(-local_correction, 0, 1, 0);
+        // Start from the correction of the last sync over these levels, if
+        // asked to and the grids have not changed since. The boundary values
+        // in the ghost zones are the ones we just computed.
+
+        if (gravity::sync_warm_start) {
+            auto it = sync_prev_delta_phi.find({crse_level, fine_level});
+            if (it != sync_prev_delta_phi.end()) {
+                bool same_grids = true;
+                for (int lev = crse_level; lev <= fine_level; ++lev) {
+                    const MultiFab& prev = *it->second[lev - crse_level];
+                    if (prev.boxArray() != grids[lev] || prev.DistributionMap() != dmap[lev]) {
+                        same_grids = false;
+                    }
+                }
+                if (same_grids) {
+                    for (int lev = crse_level; lev <= fine_level; ++lev) {
+                        MultiFab::Copy(*delta_phi[lev - crse_level], *it->second[lev - crse_level], 0, 0, 1, 0);
+                    }
+                }
+            }
         }
-    }
 
-    // Do multi-level solve for delta_phi.
+        // Do multi-level solve for delta_phi.
 
-    solve_for_delta_phi(crse_level, fine_level,
-                        amrex::GetVecOfPtrs(rhs),
-                        amrex::GetVecOfPtrs(delta_phi),
-                        amrex::GetVecOfVecOfPtrs(ec_gdPhi));
+        solve_for_delta_phi(crse_level, fine_level,
+                            amrex::GetVecOfPtrs(rhs),
+                            amrex::GetVecOfPtrs(delta_phi),
+                            amrex::GetVecOfVecOfPtrs(ec_gdPhi));
 
-    // In the all-periodic case we enforce that delta_phi averages to zero.
+        // In the all-periodic case we enforce that delta_phi averages to zero.
 
-    if (crse_geom.isAllPeriodic() && (grids[crse_level].numPts() == crse_domain.numPts()) ) {
+        if (crse_geom.isAllPeriodic() && (grids[crse_level].numPts() == crse_domain.numPts()) ) {
 
-        Real local_correction = delta_phi[0]->sum() / static_cast<Real>(grids[crse_level].numPts());
+            Real local_correction = delta_phi[0]->sum() / static_cast<Real>(grids[crse_level].numPts());
+
+            for (int lev = crse_level; lev <= fine_level; ++lev) {
+                delta_phi[lev - crse_level]->plus(-local_correction, 0, 1, 1);
+            }
 
-        for (int lev = crse_level; lev <= fine_level; ++lev) {
-            delta_phi[lev - crse_level]->plus(-local_correction, 0, 1, 1);
         }
 
-    }
+        // Add delta_phi to phi_new, and grad(delta_phi) to grad(delta_phi_curr) on each level.
+        // Update the cell-centered gravity too.
+
+        for (int lev = crse_level; lev <= fine_level; lev++) {
+
+            LevelData[lev]->get_new_data(PhiGrav_Type).plus(*delta_phi[lev - crse_level], 0, 1, 0);
 
-    // Add delta_phi to phi_new, and grad(delta_phi) to grad(delta_phi_curr) on each level.
-    // Update the cell-centered gravity too.
+            for (int n = 0; n < AMREX_SPACEDIM; n++) {
+                grad_phi_curr[lev][n]->plus(*ec_gdPhi[lev - crse_level][n], 0, 1, 0);
+            }
 
-    for (int lev = crse_level; lev <= fine_level; lev++) {
+            get_new_grav_vector(lev, LevelData[lev]->get_new_data(Gravity_Type),
+                                LevelData[lev]->get_state_data(State_Type).curTime());
 
-        LevelData[lev]->get_new_data(PhiGrav_Type).plus(*delta_phi[lev - crse_level], 0, 1, 0);
+        }
 
-        for (int n = 0; n < AMREX_SPACEDIM; n++) {
-            grad_phi_curr[lev][n]->plus(*ec_gdPhi[lev - crse_level][n], 0, 1, 0);
+        if (gravity::sync_warm_start) {
+            auto& prev = sync_prev_delta_phi[{crse_level, fine_level}];
+            prev.resize(nlevs);
+            for (int lev = crse_level; lev <= fine_level; ++lev) {
+                prev[lev - crse_level] = std::move(delta_phi[lev - crse_level]);
+            }
         }
 
-        get_new_grav_vector(lev, LevelData[lev]->get_new_data(Gravity_Type),
-                            LevelData[lev]->get_state_data(State_Type).curTime());
+    }
 
+    if (gravity::verbose > 0) {
+        amrex::Print() << " ... gravity syncs solved: " << num_syncs_solved
+                       << ", skipped: " << num_syncs_skipped << '\n';
     }
 
     int is_new = 1;
@@ -893,6 +1110,12 @@ Gravity::get_old_grav_vector(int level, MultiFab& grav_vector, Real time)
        make_radial_gravity(level,prev_time,radial_grav_old[level]);
        interpolate_monopole_grav(level,radial_grav_old[level],grav);
 
+    } else if (gravity::gravity_type == "MultipoleGrav") {
+
+       const Real prev_time = LevelData[level]->get_state_data(State_Type).prevTime();
+       MultiFab& phi = LevelData[level]->get_old_data(PhiGrav_Type);
+       make_multipole_gravity(level,prev_time,phi,grav);
+
     } else if (gravity::gravity_type == "PoissonGrav") {
 
        const Geometry& geom = parent->Geom(level);
@@ -965,6 +1188,12 @@ Gravity::get_new_grav_vector(int level, MultiFab& grav_vector, Real time)
         make_radial_gravity(level,cur_time,radial_grav_new[level]);
         interpolate_monopole_grav(level,radial_grav_new[level],grav);
 
+    } else if (gravity::gravity_type == "MultipoleGrav") {
+
+        const Real cur_time = LevelData[level]->get_state_data(State_Type).curTime();
+        MultiFab& phi = LevelData[level]->get_new_data(PhiGrav_Type);
+        make_multipole_gravity(level,cur_time,phi,grav);
+
     } else if (gravity::gravity_type == "PoissonGrav") {
 
         const Geometry& geom = parent->Geom(level);
@@ -1430,11 +1659,14 @@ Gravity::interpolate_monopole_grav(int level, RealVector& radial_grav, MultiFab&
 
 void
 Gravity::compute_radial_mass(const Box& bx,
-                             Array4<Real const> const u,
-                             RealVector& radial_mass_local,
-                             RealVector& radial_vol_local,
+                             Array4<Real const> const u_old,
+                             Array4<Real const> const u_new,
+                             Real alpha,
+                             Array4<Real const> const mask,
+                             Real* const radial_mass_ptr,
+                             Real* const radial_vol_ptr,
 #ifdef GR_GRAV
-                             RealVector& radial_pres_local,
+                             Real* const radial_pres_ptr,
 #endif
                              int n1d, int level) const
 {
@@ -1485,11 +1717,8 @@ Gravity::compute_radial_mass(const Box& bx,
     Real dy_frac = dx[1] / fac;
     Real dz_frac = dx[2] / fac;
 
-    Real* const radial_mass_ptr = radial_mass_local.dataPtr();
-    Real* const radial_vol_ptr = radial_vol_local.dataPtr();
-#ifdef GR_GRAV
-    Real* const radial_pres_ptr = radial_pres_local.dataPtr();
-#endif
+    const Real omalpha = 1.0_rt - alpha;
+    const bool has_mask = mask.dataPtr() != nullptr;
 
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -1506,29 +1735,34 @@ Gravity::compute_radial_mass(const Box& bx,
         Real r = std::sqrt(xc * xc + yc * yc + zc * zc);
         int index = static_cast<int>(r * drinv);
 
-        // We may be coming in here with a masked out zone (in a zone on a coarse
-        // level underlying a fine level). We don't want to be calling the EOS in
-        // this case, so we'll skip these masked out zones (which will have rho
-        // exactly equal to zero).
+        // Skip zones on a coarse level underlying a fine level; the fine
+        // level accounts for their mass.
 
-        if (u(i,j,k,URHO) == 0.0_rt) {
+        if (has_mask && mask(i,j,k) == 0.0_rt) {
             return;
         }
 
+        auto state = [=] (int n) -> Real
+        {
+            return omalpha * u_old(i,j,k,n) + alpha * u_new(i,j,k,n);
+        };
+
+        const Real rho = state(URHO);
+
 #ifdef GR_GRAV
-        Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+        Real rhoInv = 1.0_rt / rho;
 
         eos_t eos_state;
 
-        eos_state.rho = u(i,j,k,URHO);
-        eos_state.e   = u(i,j,k,UEINT) * rhoInv;
-        eos_state.T   = u(i,j,k,UTEMP);
+        eos_state.rho = rho;
+        eos_state.e   = state(UEINT) * rhoInv;
+        eos_state.T   = state(UTEMP);
         for (int n = 0; n < NumSpec; ++n) {
-            eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+            eos_state.xn[n] = state(UFS+n) * rhoInv;
         }
 #if NAUX_NET > 0
         for (int n = 0; n < NumAux; ++n) {
-            eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+            eos_state.aux[n] = state(UFX+n) * rhoInv;
         }
 #endif
 
@@ -1584,7 +1818,7 @@ Gravity::compute_radial_mass(const Box& bx,
                         }
 
                         if (index <= n1d - 1) {
-                            Gpu::Atomic::Add(&radial_mass_ptr[index], vol_frac * u(i,j,k,URHO));
+                            Gpu::Atomic::Add(&radial_mass_ptr[index], vol_frac * rho);
                             Gpu::Atomic::Add(&radial_vol_ptr[index], vol_frac);
 #ifdef GR_GRAV
                             Gpu::Atomic::Add(&radial_pres_ptr[index], vol_frac * eos_state.p);
@@ -1769,7 +2003,8 @@ Gravity::init_multipole_grav() const
 }
 
 void
-Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
+Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi,
+                            const std::function<void()>& overlap_work)
 {
     BL_PROFILE("Gravity::fill_multipole_BCs()");
 
@@ -1800,20 +2035,34 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
     Box boxqC( IntVect(AMREX_D_DECL(0, 0, 0)), IntVect(AMREX_D_DECL(gravity::lnum, gravity::lnum, npts-1)) );
     Box boxqS( IntVect(AMREX_D_DECL(0, 0, 0)), IntVect(AMREX_D_DECL(gravity::lnum, gravity::lnum, npts-1)) );
 
-    FArrayBox qL0(boxq0);
-    FArrayBox qLC(boxqC);
-    FArrayBox qLS(boxqS);
+    // All of the moments live in one buffer, ordered as qL0, qLC, qLS,
+    // qU0, qUC, qUS, so that a single collective reduces them.
 
-    FArrayBox qU0(boxq0);
-    FArrayBox qUC(boxqC);
-    FArrayBox qUS(boxqS);
+    const Long np0 = boxq0.numPts();
+    const Long npC = boxqC.numPts();
+    const Long npS = boxqS.numPts();
 
-    qL0.setVal<RunOn::Device>(0.0);
-    qLC.setVal<RunOn::Device>(0.0);
-    qLS.setVal<RunOn::Device>(0.0);
-    qU0.setVal<RunOn::Device>(0.0);
-    qUC.setVal<RunOn::Device>(0.0);
-    qUS.setVal<RunOn::Device>(0.0);
+    const Long npL = np0 + npC + npS;
+    const Long ntot = 2 * npL;
+
+    auto moment_arrays = [=] (Real* p) -> Array<Array4<Real>, 6>
+    {
+        return {makeArray4(p,                   boxq0, 1),
+                makeArray4(p + np0,             boxqC, 1),
+                makeArray4(p + np0 + npC,       boxqS, 1),
+                makeArray4(p + npL,             boxq0, 1),
+                makeArray4(p + npL + np0,       boxqC, 1),
+                makeArray4(p + npL + np0 + npC, boxqS, 1)};
+    };
+
+    Gpu::DeviceVector<Real> moments(ntot);
+    Real* const moments_ptr = moments.data();
+
+    amrex::ParallelFor(ntot,
+    [=] AMREX_GPU_DEVICE (Long i) noexcept
+    {
+        moments_ptr[i] = 0.0_rt;
+    });
 
     // This section needs to be generalized for computing
     // full multipole gravity, not just BCs. At present this
@@ -1825,6 +2074,18 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
     const int boundary_only = 1;
 #endif
 
+    // On the host, each thread accumulates into its own copy of the
+    // moments, and the copies are summed once at the end, rather than
+    // once per level.
+
+#ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+    Vector<Vector<Real>> priv_moments(nthreads);
+    for (int i=0; i<nthreads; i++) {
+        priv_moments[i].resize(ntot, 0.0_rt);
+    }
+#endif
+
     // Use all available data in constructing the boundary conditions,
     // unless the user has indicated that a maximum level at which
     // to stop using the more accurate data.
@@ -1859,53 +2120,25 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
         int coord_type = parent->Geom(lev).Coord();
 
 #ifdef _OPENMP
-        int nthreads = omp_get_max_threads();
-        Vector<std::unique_ptr<FArrayBox> > priv_qL0(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_qLC(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_qLS(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_qU0(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_qUC(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_qUS(nthreads);
-        for (int i=0; i<nthreads; i++) {
-            priv_qL0[i].reset(new FArrayBox(boxq0));
-            priv_qLC[i].reset(new FArrayBox(boxqC));
-            priv_qLS[i].reset(new FArrayBox(boxqS));
-            priv_qU0[i].reset(new FArrayBox(boxq0));
-            priv_qUC[i].reset(new FArrayBox(boxqC));
-            priv_qUS[i].reset(new FArrayBox(boxqS));
-        }
 #pragma omp parallel
 #endif
         {
 #ifdef _OPENMP
-            int tid = omp_get_thread_num();
-            priv_qL0[tid]->setVal<RunOn::Device>(0.0);
-            priv_qLC[tid]->setVal<RunOn::Device>(0.0);
-            priv_qLS[tid]->setVal<RunOn::Device>(0.0);
-            priv_qU0[tid]->setVal<RunOn::Device>(0.0);
-            priv_qUC[tid]->setVal<RunOn::Device>(0.0);
-            priv_qUS[tid]->setVal<RunOn::Device>(0.0);
+            auto q = moment_arrays(priv_moments[omp_get_thread_num()].data());
+#else
+            auto q = moment_arrays(moments_ptr);
 #endif
+            const auto qL0_arr = q[0];
+            const auto qLC_arr = q[1];
+            const auto qLS_arr = q[2];
+            const auto qU0_arr = q[3];
+            const auto qUC_arr = q[4];
+            const auto qUS_arr = q[5];
+
             for (MFIter mfi(source, TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
                 const Box& bx = mfi.tilebox();
 
-#ifdef _OPENMP
-                auto qL0_arr = priv_qL0[tid]->array();
-                auto qLC_arr = priv_qLC[tid]->array();
-                auto qLS_arr = priv_qLS[tid]->array();
-                auto qU0_arr = priv_qU0[tid]->array();
-                auto qUC_arr = priv_qUC[tid]->array();
-                auto qUS_arr = priv_qUS[tid]->array();
-#else
-                auto qL0_arr = qL0.array();
-                auto qLC_arr = qLC.array();
-                auto qLS_arr = qLS.array();
-                auto qU0_arr = qU0.array();
-                auto qUC_arr = qUC.array();
-                auto qUS_arr = qUS.array();
-#endif
-
                 auto rho = source[mfi].array();
                 auto vol = (*volume[lev])[mfi].array();
 
@@ -1981,174 +2214,46 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
                 });
             }
 
-#ifdef _OPENMP
-            int np0 = boxq0.numPts();
-            int npC = boxqC.numPts();
-            int npS = boxqS.numPts();
-            Real* pL0 = qL0.dataPtr();
-            Real* pLC = qLC.dataPtr();
-            Real* pLS = qLS.dataPtr();
-            Real* pU0 = qU0.dataPtr();
-            Real* pUC = qUC.dataPtr();
-            Real* pUS = qUS.dataPtr();
-#pragma omp barrier
-#pragma omp for nowait
-            for (int i=0; i<np0; ++i)
-            {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pp = priv_qL0[it]->dataPtr();
-                    pL0[i] += pp[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<npC; ++i)
-            {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pp = priv_qLC[it]->dataPtr();
-                    pLC[i] += pp[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<npS; ++i)
-            {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pp = priv_qLS[it]->dataPtr();
-                    pLS[i] += pp[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<np0; ++i)
-            {
-                for (int it=0; it<nthreads; it++) {
-                  const Real* pp = priv_qU0[it]->dataPtr();
-                  pU0[i] += pp[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<npC; ++i)
-            {
-                for (int it=0; it<nthreads; it++) {
-                  const Real* pp = priv_qUC[it]->dataPtr();
-                  pUC[i] += pp[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<npS; ++i)
-            {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pp = priv_qUS[it]->dataPtr();
-                    pUS[i] += pp[i];
-                }
-            }
-#endif
-
         } // end OpenMP parallel loop
 
     } // end loop over levels
 
-    // Now, do a global reduce over all processes.
-
-    Real* qL0_ptr = qL0.dataPtr();
-    Real* qLC_ptr = qLC.dataPtr();
-    Real* qLS_ptr = qLS.dataPtr();
-
-    // Create temporary pinned host containers in case we need them.
-
-    FArrayBox qL0_host(The_Pinned_Arena());
-    FArrayBox qLC_host(The_Pinned_Arena());
-    FArrayBox qLS_host(The_Pinned_Arena());
-
-    if (!ParallelDescriptor::UseGpuAwareMpi()) {
-        if (The_Arena() == The_Managed_Arena()) {
-            qL0.prefetchToHost();
-            qLC.prefetchToHost();
-            qLS.prefetchToHost();
-        }
-        else if (The_Arena() == The_Device_Arena()) {
-            qL0_host.resize(boxq0);
-            qLC_host.resize(boxqC);
-            qLS_host.resize(boxqS);
-
-            qL0_host.copy<RunOn::Device>(qL0, boxq0);
-            qLC_host.copy<RunOn::Device>(qLC, boxqC);
-            qLS_host.copy<RunOn::Device>(qLS, boxqS);
-
-            qL0_ptr = qL0_host.dataPtr();
-            qLC_ptr = qLC_host.dataPtr();
-            qLS_ptr = qLS_host.dataPtr();
-        }
-    }
-
-    Gpu::synchronize();
-
-    ParallelDescriptor::ReduceRealSum(qL0_ptr, static_cast<int>(boxq0.numPts()));
-    ParallelDescriptor::ReduceRealSum(qLC_ptr, static_cast<int>(boxqC.numPts()));
-    ParallelDescriptor::ReduceRealSum(qLS_ptr, static_cast<int>(boxqS.numPts()));
+#ifdef _OPENMP
+    // Sum the thread-private moments into the shared buffer.
 
-    if (!ParallelDescriptor::UseGpuAwareMpi()) {
-        if (The_Arena() == The_Managed_Arena()) {
-            qL0.prefetchToDevice();
-            qLC.prefetchToDevice();
-            qLS.prefetchToDevice();
-        }
-        else if (The_Arena() == The_Device_Arena()) {
-            qL0.copy<RunOn::Device>(qL0_host, boxq0);
-            qLC.copy<RunOn::Device>(qLC_host, boxqC);
-            qLS.copy<RunOn::Device>(qLS_host, boxqS);
+#pragma omp parallel for
+    for (Long i = 0; i < ntot; ++i)
+    {
+        for (int it = 0; it < nthreads; it++) {
+            moments_ptr[i] += priv_moments[it][i];
         }
     }
+#endif
 
-    if (boundary_only != 1) {
-
-        Real* qU0_ptr = qU0.dataPtr();
-        Real* qUC_ptr = qUC.dataPtr();
-        Real* qUS_ptr = qUS.dataPtr();
-
-        FArrayBox qU0_host(The_Pinned_Arena());
-        FArrayBox qUC_host(The_Pinned_Arena());
-        FArrayBox qUS_host(The_Pinned_Arena());
+    // Now, do a global reduce over all processes. Only the exterior
+    // moments are needed for the boundary values; the reduction runs
+    // in the background while the caller does any independent work.
 
-        if (!ParallelDescriptor::UseGpuAwareMpi()) {
-            if (The_Arena() == The_Managed_Arena()) {
-                qU0.prefetchToHost();
-                qUC.prefetchToHost();
-                qUS.prefetchToHost();
-            }
-            else if (The_Arena() == The_Device_Arena()) {
-                qU0_host.resize(boxq0);
-                qUC_host.resize(boxqC);
-                qUS_host.resize(boxqS);
+    const Real red_strt = ParallelDescriptor::second();
 
-                qU0_host.copy<RunOn::Device>(qU0, boxq0);
-                qUC_host.copy<RunOn::Device>(qUC, boxqC);
-                qUS_host.copy<RunOn::Device>(qUS, boxqS);
+    BufferReduction reduction;
+    reduction.start(moments_ptr, boundary_only == 1 ? npL : ntot);
 
-                qU0_ptr = qU0_host.dataPtr();
-                qUC_ptr = qUC_host.dataPtr();
-                qUS_ptr = qUS_host.dataPtr();
-            }
-        }
+    if (overlap_work) {
+        overlap_work();
+    }
 
-        Gpu::synchronize();
+    const Real wait_strt = ParallelDescriptor::second();
 
-        ParallelDescriptor::ReduceRealSum(qU0_ptr, static_cast<int>(boxq0.numPts()));
-        ParallelDescriptor::ReduceRealSum(qUC_ptr, static_cast<int>(boxqC.numPts()));
-        ParallelDescriptor::ReduceRealSum(qUS_ptr, static_cast<int>(boxqS.numPts()));
+    reduction.finish();
 
-        if (!ParallelDescriptor::UseGpuAwareMpi()) {
-            if (The_Arena() == The_Managed_Arena()) {
-                qU0.prefetchToDevice();
-                qUC.prefetchToDevice();
-                qUS.prefetchToDevice();
-            }
-            else if (The_Arena() == The_Device_Arena()) {
-                qU0.copy<RunOn::Device>(qU0_host, boxq0);
-                qUC.copy<RunOn::Device>(qUC_host, boxqC);
-                qUS.copy<RunOn::Device>(qUS_host, boxqS);
-            }
-        }
+    const Real wait_time = ParallelDescriptor::second() - wait_strt;
+    const Real red_time = ParallelDescriptor::second() - red_strt;
 
-    }
+    auto q = moment_arrays(moments_ptr);
+    const auto qL0_arr = q[0];
+    const auto qLC_arr = q[1];
+    const auto qLS_arr = q[2];
 
     // Finally, construct the boundary conditions using the
     // complete multipole moments, for all points on the
@@ -2166,9 +2271,6 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
     {
         const Box& bx = mfi.growntilebox();
 
-        auto qL0_arr = qL0.array();
-        auto qLC_arr = qLC.array();
-        auto qLS_arr = qLS.array();
         auto phi_arr = phi[mfi].array();
 
         amrex::ParallelFor(bx,
@@ -2314,16 +2416,22 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
         });
     }
 
+    // The moments buffer is freed on return.
+
+    Gpu::streamSynchronize();
+
     if (gravity::verbose)
     {
         const int IOProc = ParallelDescriptor::IOProcessorNumber();
-        Real      end    = ParallelDescriptor::second() - strt;
+        Real times[3] = {ParallelDescriptor::second() - strt, red_time, wait_time};
 
 #ifdef BL_LAZY
         Lazy::QueueReduction( [=] () mutable {
 #endif
-        ParallelDescriptor::ReduceRealMax(end,IOProc);
-        amrex::Print() << "Gravity::fill_multipole_BCs() time = " << end << std::endl << std::endl;
+        ParallelDescriptor::ReduceRealMax(times, 3, IOProc);
+        amrex::Print() << "Gravity::fill_multipole_BCs() time = " << times[0] << std::endl;
+        amrex::Print() << "    reduction time = " << times[1]
+                       << ", of which waiting = " << times[2] << std::endl << std::endl;
 #ifdef BL_LAZY
         });
 #endif
@@ -2333,7 +2441,8 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
 
 #if (AMREX_SPACEDIM == 3)
 void
-Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
+Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi,
+                             const std::function<void()>& overlap_work)
 {
     BL_PROFILE("Gravity::fill_direct_sum_BCs()");
 
@@ -2355,7 +2464,7 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
     const int hiVectXZ[3] = {domhi[0]+1, 0         , domhi[2]+1};
 
     const int loVectYZ[3] = {0         , domlo[1]-1, domlo[2]-1};
-    const int hiVectYZ[3] = {0         , domhi[1]+1, domhi[1]+1};
+    const int hiVectYZ[3] = {0         , domhi[1]+1, domhi[2]+1};
 
     const int bc_lo[3] = {domlo[0]-1, domlo[1]-1, domlo[2]-1};
     const int bc_hi[3] = {domhi[0]+1, domhi[1]+1, domhi[2]+1};
@@ -2395,23 +2504,33 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
     Box boxXZ(smallEndXZ, bigEndXZ);
     Box boxYZ(smallEndYZ, bigEndYZ);
 
-    const long nPtsXY = boxXY.numPts();
-    const long nPtsXZ = boxXZ.numPts();
-    const long nPtsYZ = boxYZ.numPts();
+    const Long nPtsXY = boxXY.numPts();
+    const Long nPtsXZ = boxXZ.numPts();
+    const Long nPtsYZ = boxYZ.numPts();
 
-    FArrayBox bcXYLo(boxXY);
-    FArrayBox bcXYHi(boxXY);
-    FArrayBox bcXZLo(boxXZ);
-    FArrayBox bcXZHi(boxXZ);
-    FArrayBox bcYZLo(boxYZ);
-    FArrayBox bcYZHi(boxYZ);
+    // All six faces live in one buffer so that a single collective
+    // reduces them.
 
-    bcXYLo.setVal<RunOn::Device>(0.0);
-    bcXYHi.setVal<RunOn::Device>(0.0);
-    bcXZLo.setVal<RunOn::Device>(0.0);
-    bcXZHi.setVal<RunOn::Device>(0.0);
-    bcYZLo.setVal<RunOn::Device>(0.0);
-    bcYZHi.setVal<RunOn::Device>(0.0);
+    const Long ntot = 2 * (nPtsXY + nPtsXZ + nPtsYZ);
+
+    auto face_arrays = [=] (Real* p) -> Array<Array4<Real>, 6>
+    {
+        return {makeArray4(p,                                boxXY, 1),
+                makeArray4(p + nPtsXY,                       boxXY, 1),
+                makeArray4(p + 2 * nPtsXY,                   boxXZ, 1),
+                makeArray4(p + 2 * nPtsXY + nPtsXZ,          boxXZ, 1),
+                makeArray4(p + 2 * (nPtsXY + nPtsXZ),          boxYZ, 1),
+                makeArray4(p + 2 * (nPtsXY + nPtsXZ) + nPtsYZ, boxYZ, 1)};
+    };
+
+    Gpu::DeviceVector<Real> bc(ntot);
+    Real* const bc_ptr = bc.data();
+
+    amrex::ParallelFor(ntot,
+    [=] AMREX_GPU_DEVICE (Long i) noexcept
+    {
+        bc_ptr[i] = 0.0_rt;
+    });
 
     // Loop through the grids and compute the individual contributions
     // to the BCs. The BC constructor is coded to only add to the
@@ -2425,6 +2544,18 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
         physbc_hi[dir] = phys_bc->hi(dir);
     }
 
+    // On the host, each thread accumulates into its own copy of the
+    // faces, and the copies are summed once at the end, rather than
+    // once per level.
+
+#ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+    Vector<Vector<Real>> priv_bc(nthreads);
+    for (int i=0; i<nthreads; i++) {
+        priv_bc[i].resize(ntot, 0.0_rt);
+    }
+#endif
+
     for (int lev = crse_level; lev <= fine_level; ++lev) {
 
         // Create a local copy of the RHS so that we can mask it.
@@ -2443,33 +2574,21 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
         const auto dx = parent->Geom(lev).CellSizeArray();
 
 #ifdef _OPENMP
-        int nthreads = omp_get_max_threads();
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXYLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXYHi(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXZLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcXZHi(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcYZLo(nthreads);
-        Vector<std::unique_ptr<FArrayBox> > priv_bcYZHi(nthreads);
-        for (int i=0; i<nthreads; i++) {
-            priv_bcXYLo[i].reset(new FArrayBox(boxXY));
-            priv_bcXYHi[i].reset(new FArrayBox(boxXY));
-            priv_bcXZLo[i].reset(new FArrayBox(boxXZ));
-            priv_bcXZHi[i].reset(new FArrayBox(boxXZ));
-            priv_bcYZLo[i].reset(new FArrayBox(boxYZ));
-            priv_bcYZHi[i].reset(new FArrayBox(boxYZ));
-        }
 #pragma omp parallel
 #endif
         {
 #ifdef _OPENMP
-            int tid = omp_get_thread_num();
-            priv_bcXYLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXYHi[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXZLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcXZHi[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcYZLo[tid]->setVal<RunOn::Gpu>(0.0);
-            priv_bcYZHi[tid]->setVal<RunOn::Gpu>(0.0);
+            auto bcf = face_arrays(priv_bc[omp_get_thread_num()].data());
+#else
+            auto bcf = face_arrays(bc_ptr);
 #endif
+            const auto bcXYLo_arr = bcf[0];
+            const auto bcXYHi_arr = bcf[1];
+            const auto bcXZLo_arr = bcf[2];
+            const auto bcXZHi_arr = bcf[3];
+            const auto bcYZLo_arr = bcf[4];
+            const auto bcYZHi_arr = bcf[5];
+
             for (MFIter mfi(source, TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
                 const Box bx = mfi.tilebox();
@@ -2495,22 +2614,6 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
                     }
                 }
 
-#ifdef _OPENMP
-                auto bcXYLo_arr = priv_bcXYLo[tid]->array();
-                auto bcXYHi_arr = priv_bcXYHi[tid]->array();
-                auto bcXZLo_arr = priv_bcXZLo[tid]->array();
-                auto bcXZHi_arr = priv_bcXZHi[tid]->array();
-                auto bcYZLo_arr = priv_bcYZLo[tid]->array();
-                auto bcYZHi_arr = priv_bcYZHi[tid]->array();
-#else
-                auto bcXYLo_arr = bcXYLo.array();
-                auto bcXYHi_arr = bcXYHi.array();
-                auto bcXZLo_arr = bcXZLo.array();
-                auto bcXZHi_arr = bcXZHi.array();
-                auto bcYZLo_arr = bcYZLo.array();
-                auto bcYZHi_arr = bcYZHi.array();
-#endif
-
                 amrex::ParallelFor(bx,
                 [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
                 {
@@ -2552,7 +2655,7 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
                                 locb[0] = problo[0];
                             }
                             else if (l == bc_hi[0]) {
-                                locb[0] = probhi[1];
+                                locb[0] = probhi[0];
                             }
                             else {
                                 locb[0] = problo[0] + (static_cast<Real>(l) + 0.5_rt) * bc_dx[0];
@@ -2732,73 +2835,57 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
 
             }
 
-#ifdef _OPENMP
-            Real* pXYLo = bcXYLo.dataPtr();
-            Real* pXYHi = bcXYHi.dataPtr();
-            Real* pXZLo = bcXZLo.dataPtr();
-            Real* pXZHi = bcXZHi.dataPtr();
-            Real* pYZLo = bcYZLo.dataPtr();
-            Real* pYZHi = bcYZHi.dataPtr();
-#pragma omp barrier
-#pragma omp for nowait
-            for (int i=0; i<nPtsXY; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcXYLo[it]->dataPtr();
-                    const Real* ph = priv_bcXYHi[it]->dataPtr();
-                    pXYLo[i] += pl[i];
-                    pXYHi[i] += ph[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<nPtsXZ; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcXZLo[it]->dataPtr();
-                    const Real* ph = priv_bcXZHi[it]->dataPtr();
-                    pXZLo[i] += pl[i];
-                    pXZHi[i] += ph[i];
-                }
-            }
-#pragma omp for nowait
-            for (int i=0; i<nPtsYZ; i++) {
-                for (int it=0; it<nthreads; it++) {
-                    const Real* pl = priv_bcYZLo[it]->dataPtr();
-                    const Real* ph = priv_bcYZHi[it]->dataPtr();
-                    pYZLo[i] += pl[i];
-                    pYZHi[i] += ph[i];
-                }
-            }
-#endif
         }
 
     } // end loop over levels
 
-    // because the number of elements in mpi_reduce is int
-    BL_ASSERT(nPtsXY <= std::numeric_limits<int>::max());
-    BL_ASSERT(nPtsXZ <= std::numeric_limits<int>::max());
-    BL_ASSERT(nPtsYZ <= std::numeric_limits<int>::max());
-
-    ParallelDescriptor::ReduceRealSum(bcXYLo.dataPtr(), static_cast<int>(nPtsXY));
-    ParallelDescriptor::ReduceRealSum(bcXYHi.dataPtr(), static_cast<int>(nPtsXY));
-    ParallelDescriptor::ReduceRealSum(bcXZLo.dataPtr(), static_cast<int>(nPtsXZ));
-    ParallelDescriptor::ReduceRealSum(bcXZHi.dataPtr(), static_cast<int>(nPtsXZ));
-    ParallelDescriptor::ReduceRealSum(bcYZLo.dataPtr(), static_cast<int>(nPtsYZ));
-    ParallelDescriptor::ReduceRealSum(bcYZHi.dataPtr(), static_cast<int>(nPtsYZ));
-
 #ifdef _OPENMP
-#pragma omp parallel
-#endif
-    for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const Box& bx= mfi.growntilebox();
+    // Sum the thread-private faces into the shared buffer.
 
-        auto p = phi[mfi].array();
+#pragma omp parallel for
+    for (Long i = 0; i < ntot; ++i)
+    {
+        for (int it = 0; it < nthreads; it++) {
+            bc_ptr[i] += priv_bc[it][i];
+        }
+    }
+#endif
+
+    // Now, do a global reduce over all processes, in the background
+    // while the caller does any independent work.
+
+    const Real red_strt = ParallelDescriptor::second();
+
+    BufferReduction reduction;
+    reduction.start(bc_ptr, ntot);
+
+    if (overlap_work) {
+        overlap_work();
+    }
+
+    const Real wait_strt = ParallelDescriptor::second();
+
+    reduction.finish();
 
-        auto bcXYLo_arr = bcXYLo.array();
-        auto bcXYHi_arr = bcXYHi.array();
-        auto bcXZLo_arr = bcXZLo.array();
-        auto bcXZHi_arr = bcXZHi.array();
-        auto bcYZLo_arr = bcYZLo.array();
-        auto bcYZHi_arr = bcYZHi.array();
+    const Real wait_time = ParallelDescriptor::second() - wait_strt;
+    const Real red_time = ParallelDescriptor::second() - red_strt;
+
+    auto bcf = face_arrays(bc_ptr);
+    const auto bcXYLo_arr = bcf[0];
+    const auto bcXYHi_arr = bcf[1];
+    const auto bcXZLo_arr = bcf[2];
+    const auto bcXZHi_arr = bcf[3];
+    const auto bcYZLo_arr = bcf[4];
+    const auto bcYZHi_arr = bcf[5];
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx= mfi.growntilebox();
+
+        auto p = phi[mfi].array();
 
         amrex::ParallelFor(bx,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -2829,16 +2916,22 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
         });
     }
 
+    // The BC buffer is freed on return.
+
+    Gpu::streamSynchronize();
+
     if (gravity::verbose)
     {
         const int IOProc = ParallelDescriptor::IOProcessorNumber();
-        Real      end    = ParallelDescriptor::second() - strt;
+        Real times[3] = {ParallelDescriptor::second() - strt, red_time, wait_time};
 
 #ifdef BL_LAZY
         Lazy::QueueReduction( [=] () mutable {
 #endif
-        ParallelDescriptor::ReduceRealMax(end,IOProc);
-        amrex::Print() << "Gravity::fill_direct_sum_BCs() time = " << end << std::endl << std::endl;
+        ParallelDescriptor::ReduceRealMax(times, 3, IOProc);
+        amrex::Print() << "Gravity::fill_direct_sum_BCs() time = " << times[0] << std::endl;
+        amrex::Print() << "    reduction time = " << times[1]
+                       << ", of which waiting = " << times[2] << std::endl << std::endl;
 #ifdef BL_LAZY
         });
 #endif
@@ -3080,132 +3173,464 @@ Gravity::add_pointmass_to_gravity (int level, MultiFab& phi, MultiFab& grav_vect
 }
 
 void
-Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
+Gravity::make_multipole_gravity(int level, Real time, MultiFab& phi, MultiFab& grav_vector)
 {
-    BL_PROFILE("Gravity::make_radial_gravity()");
+    BL_PROFILE("Gravity::make_multipole_gravity()");
 
     const Real strt = ParallelDescriptor::second();
 
-    // This is just here in case we need to debug ...
-    int do_diag = 0;
+    const Geometry& geom = parent->Geom(level);
+    const auto dx = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const auto probhi = geom.ProbHiArray();
 
-    Real sum_over_levels = 0.;
+    // The moments of the mass on this level and all coarser levels are
+    // binned onto radial shells of width dr = dx / drdxfac on this level.
+    // We need enough shells to reach every point that we evaluate the
+    // potential at, which includes the ghost zones and the faces that
+    // we difference to get the gravity. As in fill_multipole_BCs, all
+    // distances are in units of rmax.
 
-    for (int lev = 0; lev <= level; lev++)
+    const Real dr = dx[0] / static_cast<Real>(gravity::drdxfac);
+    const Real drInv = multipole::rmax / dr;
+
+    const int ng = amrex::max(phi.nGrow(), grav_vector.nGrow()) + 1;
+
+    Real rfar_sq = 0.0_rt;
+    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+        Real lo = problo[n] - ng * dx[n] - problem::center[n];
+        Real hi = probhi[n] + ng * dx[n] - problem::center[n];
+        rfar_sq += amrex::max(lo * lo, hi * hi);
+    }
+
+    const int nshells = static_cast<int>(std::sqrt(rfar_sq) / dr) + 1;
+
+    // All of the moments live in one buffer so that a single reduction
+    // covers them. The third index runs over the nshells + 1 shell edges;
+    // while binning, entry n holds the moments of shell n itself.
+
+    const int lnum = gravity::lnum;
+
+    const int n0 = (lnum + 1) * (nshells + 1);
+    const int nCS = (lnum + 1) * (lnum + 1) * (nshells + 1);
+    const int ntot = 2 * n0 + 4 * nCS;
+
+    // Offsets of qL0, qU0, qLC, qLS, qUC, qUS.
+
+    const Array<int, 6> qoffset = {0, n0, 2 * n0, 2 * n0 + nCS, 2 * n0 + 2 * nCS, 2 * n0 + 3 * nCS};
+
+    auto moments_array = [=] (Real* p, int q) -> Array4<Real>
     {
-        const Real t_old = LevelData[lev]->get_state_data(State_Type).prevTime();
-        const Real t_new = LevelData[lev]->get_state_data(State_Type).curTime();
-        const Real eps   = (t_new - t_old) * 1.e-6;
+        const Dim3 qlo{0, 0, 0};
+        const Dim3 qhi{lnum + 1, q < 2 ? 1 : lnum + 1, nshells + 1};
+        return Array4<Real>(p + qoffset[q], qlo, qhi, 1);
+    };
 
-        // Create MultiFab with NUM_STATE components and no ghost cells
-        MultiFab S(grids[lev],dmap[lev],NUM_STATE,0);
+    RealVector moments(ntot, 0.0_rt);
 
-        if ( eps == 0.0 ) {  // NOLINT(bugprone-branch-clone,-warnings-as-errors)
-            // Old and new time are identical; this should only happen if
-            // dt is smaller than roundoff compared to the current time,
-            // in which case we're probably in trouble anyway,
-            // but we will still handle it gracefully here.
-            MultiFab::Copy(S, LevelData[lev]->get_new_data(State_Type), 0, 0, NUM_STATE, 0);
-        }
-        else if ( std::abs(time-t_old) < eps)
-        {
-            MultiFab::Copy(S, LevelData[lev]->get_old_data(State_Type), 0, 0, NUM_STATE, 0);
-        }
-        else if ( std::abs(time-t_new) < eps)
+    const Real rmax_cubed_inv = 1.0_rt / (multipole::rmax * multipole::rmax * multipole::rmax);
+
+    for (int lev = 0; lev <= level; ++lev)
+    {
+        const MultiFab* S_old = nullptr;
+        const MultiFab* S_new = nullptr;
+        Real alpha = 1.0_rt;
+
+        state_at_time(lev, time, S_old, S_new, alpha);
+
+        const Real omalpha = 1.0_rt - alpha;
+
+        const MultiFab* mask = nullptr;
+
+        if (lev < level)
         {
-            MultiFab::Copy(S, LevelData[lev]->get_new_data(State_Type), 0, 0, NUM_STATE, 0);
+            auto* fine_level = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)));
+            if (fine_level != nullptr) {
+                mask = &(fine_level->build_fine_mask());
+            } else {
+                amrex::Abort("unable to create mask");
+            }
         }
-        else if (time > t_old && time < t_new)
-        {
-            Real alpha   = (time - t_old)/(t_new - t_old);
-            Real omalpha = 1.0 - alpha;
 
-            MultiFab::Copy(S, LevelData[lev]->get_old_data(State_Type), 0, 0, NUM_STATE, 0);
-            S.mult(omalpha);
+        const bool has_mask = mask != nullptr;
 
-            MultiFab S_new(grids[lev],dmap[lev],NUM_STATE,0);
-            MultiFab::Copy(S_new, LevelData[lev]->get_new_data(State_Type), 0, 0, NUM_STATE, 0);
-            S_new.mult(alpha);
+        const auto lev_dx = parent->Geom(lev).CellSizeArray();
 
-            S.plus(S_new,0,NUM_STATE,0);
+#ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+        Vector< RealVector > priv_moments(nthreads);
+        for (int i=0; i<nthreads; i++) {
+            priv_moments[i].resize(ntot,0.0);
         }
-        else
+#pragma omp parallel
+#endif
         {
-            std::cout << " Level / Time in make_radial_gravity is: " << lev << " " << time  << std::endl;
-            std::cout << " but old / new time      are: " << t_old << " " << t_new << std::endl;
-            amrex::Abort("Problem in Gravity::make_radial_gravity");
-        }
+#ifdef _OPENMP
+            Real* const lev_moments = priv_moments[omp_get_thread_num()].dataPtr();
+#else
+            Real* const lev_moments = moments.dataPtr();
+#endif
 
-        if (lev < level)
-        {
-            auto* fine_level = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)));
-        if (fine_level != nullptr) {
-        const MultiFab& mask = fine_level->build_fine_mask();
-        for (int n = 0; n < NUM_STATE; ++n) {
-            MultiFab::Multiply(S, mask, 0, n, 1, 0);
+            auto qL0 = moments_array(lev_moments, 0);
+            auto qU0 = moments_array(lev_moments, 1);
+            auto qLC = moments_array(lev_moments, 2);
+            auto qLS = moments_array(lev_moments, 3);
+            auto qUC = moments_array(lev_moments, 4);
+            auto qUS = moments_array(lev_moments, 5);
+
+            for (MFIter mfi(*S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.tilebox();
+
+                auto u_old = (*S_old)[mfi].const_array();
+                auto u_new = (*S_new)[mfi].const_array();
+                auto vol = (*volume[lev])[mfi].const_array();
+                auto lev_mask = has_mask ? mask->const_array(mfi) : Array4<Real const>{};
+
+                amrex::ParallelFor(bx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    // Skip zones on a coarse level underlying a fine level; the fine
+                    // level accounts for their mass.
+
+                    if (has_mask && lev_mask(i,j,k) == 0.0_rt) {
+                        return;
+                    }
+
+                    Real x = (problo[0] + (static_cast<Real>(i) + 0.5_rt) * lev_dx[0] - problem::center[0]) / multipole::rmax;
+
+#if AMREX_SPACEDIM >= 2
+                    Real y = (problo[1] + (static_cast<Real>(j) + 0.5_rt) * lev_dx[1] - problem::center[1]) / multipole::rmax;
+#else
+                    Real y = 0.0_rt;
+#endif
+
+#if AMREX_SPACEDIM == 3
+                    Real z = (problo[2] + (static_cast<Real>(k) + 0.5_rt) * lev_dx[2] - problem::center[2]) / multipole::rmax;
+#else
+                    Real z = 0.0_rt;
+#endif
+
+                    Real r = std::sqrt(x * x + y * y + z * z);
+
+                    Real cosTheta = 1.0_rt;
+                    Real phiAngle = 0.0_rt;
+
+                    if (r > 0.0_rt) {
+                        if (AMREX_SPACEDIM == 3) {
+                            cosTheta = z / r;
+                            phiAngle = std::atan2(y, x);
+                        }
+                        else {
+                            cosTheta = y / r;
+                        }
+                    }
+
+                    int index = amrex::min(static_cast<int>(r * drInv), nshells - 1);
+
+                    Real rho = omalpha * u_old(i,j,k,URHO) + alpha * u_new(i,j,k,URHO);
+
+                    multipole_shell_add(cosTheta, phiAngle, r, rho, vol(i,j,k) * rmax_cubed_inv,
+                                        qL0, qLC, qLS, qU0, qUC, qUS,
+                                        index);
+                });
+            }
+
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp for
+            for (int i=0; i<ntot; i++) {
+                for (int it=0; it<nthreads; it++) {
+                    moments[i] += priv_moments[it][i];
+                }
+            }
+#endif
         }
-        } else {
-                amrex::Abort("unable to create mask");
+    }
+
+    Gpu::synchronize();
+
+    if (!ParallelDescriptor::UseGpuAwareMpi()) {
+        Gpu::prefetchToHost(moments.begin(), moments.end());
+    }
+
+    ParallelDescriptor::ReduceRealSum(moments.dataPtr(), ntot);
+
+    Gpu::prefetchToHost(moments.begin(), moments.end());
+
+    // Turn the moments of each shell into moments on the shell edges:
+    // the interior moments of all of the mass inside each edge, and the
+    // exterior moments of all of the mass outside of it. This is a
+    // short serial scan, so we just do it on the host.
+
+    for (int q = 0; q < 6; ++q) {
+
+        auto qarr = moments_array(moments.dataPtr(), q);
+
+        const bool interior = (q == 0 || q == 2 || q == 3);
+        const int mlo = (q < 2) ? 0 : 1;
+        const int mhi = (q < 2) ? 0 : lnum;
+
+        for (int m = mlo; m <= mhi; ++m) {
+            for (int l = m; l <= lnum; ++l) {
+
+                if (interior) {
+                    Real sum = 0.0_rt;
+                    for (int n = 0; n <= nshells; ++n) {
+                        Real dq = qarr(l,m,n);
+                        qarr(l,m,n) = sum;
+                        sum += dq;
+                    }
+                }
+                else {
+                    for (int n = nshells - 1; n >= 0; --n) {
+                        qarr(l,m,n) += qarr(l,m,n+1);
+                    }
+                }
+
             }
         }
 
-        int n1d = static_cast<int>(radial_mass[lev].size());
+    }
 
-#ifdef GR_GRAV
-        Real* const lev_pres = radial_pres[lev].dataPtr();
+    Gpu::prefetchToDevice(moments.begin(), moments.end());
+
+    Array4<Real const> const qL0 = moments_array(moments.dataPtr(), 0);
+    Array4<Real const> const qU0 = moments_array(moments.dataPtr(), 1);
+    Array4<Real const> const qLC = moments_array(moments.dataPtr(), 2);
+    Array4<Real const> const qLS = moments_array(moments.dataPtr(), 3);
+    Array4<Real const> const qUC = moments_array(moments.dataPtr(), 4);
+    Array4<Real const> const qUS = moments_array(moments.dataPtr(), 5);
+
+    // Now evaluate the potential at the zone centers, and the gravity by
+    // differencing the potential across each zone. Both include the ghost
+    // zones, so no fill is needed here.
+
+#ifdef _OPENMP
+#pragma omp parallel
 #endif
-        Real* const lev_vol = radial_vol[lev].dataPtr();
-        Real* const lev_mass = radial_mass[lev].dataPtr();
+    for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox();
 
-        amrex::ParallelFor(n1d,
-        [=] AMREX_GPU_DEVICE (int i) noexcept
+        auto phi_arr = phi.array(mfi);
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-#ifdef GR_GRAV
-            lev_pres[i] = 0.;
+            Real x = (problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0]) / multipole::rmax;
+
+#if AMREX_SPACEDIM >= 2
+            Real y = (problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1]) / multipole::rmax;
+#else
+            Real y = 0.0_rt;
+#endif
+
+#if AMREX_SPACEDIM == 3
+            Real z = (problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2]) / multipole::rmax;
+#else
+            Real z = 0.0_rt;
 #endif
-            lev_vol[i] = 0.;
-            lev_mass[i] = 0.;
+
+            phi_arr(i,j,k) = multipole_shell_phi(x, y, z, drInv, nshells,
+                                                 qL0, qLC, qLS, qU0, qUC, qUS);
         });
+    }
 
 #ifdef _OPENMP
-        int nthreads = omp_get_max_threads();
-#ifdef GR_GRAV
-        Vector< RealVector > priv_radial_pres(nthreads);
+#pragma omp parallel
 #endif
-        Vector< RealVector > priv_radial_mass(nthreads);
-        Vector< RealVector > priv_radial_vol (nthreads);
-        for (int i=0; i<nthreads; i++) {
+    for (MFIter mfi(grav_vector, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox();
+
+        auto grav = grav_vector.array(mfi);
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            GpuArray<Real, 3> loc = {0.0_rt, 0.0_rt, 0.0_rt};
+
+            loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0];
+
+#if AMREX_SPACEDIM >= 2
+            loc[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1];
+#endif
+
+#if AMREX_SPACEDIM == 3
+            loc[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2];
+#endif
+
+            for (int n = 0; n < AMREX_SPACEDIM; ++n) {
+
+                GpuArray<Real, 3> lo = loc;
+                GpuArray<Real, 3> hi = loc;
+
+                lo[n] -= 0.5_rt * dx[n];
+                hi[n] += 0.5_rt * dx[n];
+
+                Real phi_lo = multipole_shell_phi(lo[0] / multipole::rmax, lo[1] / multipole::rmax, lo[2] / multipole::rmax,
+                                                  drInv, nshells, qL0, qLC, qLS, qU0, qUC, qUS);
+                Real phi_hi = multipole_shell_phi(hi[0] / multipole::rmax, hi[1] / multipole::rmax, hi[2] / multipole::rmax,
+                                                  drInv, nshells, qL0, qLC, qLS, qU0, qUC, qUS);
+
+                grav(i,j,k,n) = -(phi_hi - phi_lo) / dx[n];
+
+            }
+        });
+    }
+
+    // The moments are freed when we leave, so wait for the kernels.
+
+    Gpu::synchronize();
+
+    if (gravity::verbose)
+    {
+        const int IOProc = ParallelDescriptor::IOProcessorNumber();
+        Real      end    = ParallelDescriptor::second() - strt;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(end,IOProc);
+        amrex::Print() << "Gravity::make_multipole_gravity() time = " << end << std::endl << std::endl;
+#ifdef BL_LAZY
+        });
+#endif
+    }
+}
+
+void
+Gravity::state_at_time(int lev, Real time,
+                       const MultiFab*& S_old, const MultiFab*& S_new,
+                       Real& alpha) const
+{
+    const Real t_old = LevelData[lev]->get_state_data(State_Type).prevTime();
+    const Real t_new = LevelData[lev]->get_state_data(State_Type).curTime();
+    const Real eps   = (t_new - t_old) * 1.e-6;
+
+    // When only one time level is needed we point both at it.
+
+    S_old = &(LevelData[lev]->get_new_data(State_Type));
+    S_new = S_old;
+    alpha = 1.0_rt;
+
+    if ( eps == 0.0 ) {  // NOLINT(bugprone-branch-clone,-warnings-as-errors)
+        // Old and new time are identical; this should only happen if
+        // dt is smaller than roundoff compared to the current time,
+        // in which case we're probably in trouble anyway,
+        // but we will still handle it gracefully here.
+        alpha = 1.0_rt;
+    }
+    else if ( std::abs(time-t_old) < eps)
+    {
+        S_old = &(LevelData[lev]->get_old_data(State_Type));
+        S_new = S_old;
+        alpha = 0.0_rt;
+    }
+    else if ( std::abs(time-t_new) < eps)
+    {
+        alpha = 1.0_rt;
+    }
+    else if (time > t_old && time < t_new)
+    {
+        S_old = &(LevelData[lev]->get_old_data(State_Type));
+        alpha = (time - t_old)/(t_new - t_old);
+    }
+    else
+    {
+        std::cout << " Level / Time in Gravity::state_at_time is: " << lev << " " << time  << std::endl;
+        std::cout << " but old / new time      are: " << t_old << " " << t_new << std::endl;
+        amrex::Abort("Problem in Gravity::state_at_time");
+    }
+}
+
+void
+Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
+{
+    BL_PROFILE("Gravity::make_radial_gravity()");
+
+    const Real strt = ParallelDescriptor::second();
+
+    // This is just here in case we need to debug ...
+    int do_diag = 0;
+
+    Real sum_over_levels = 0.;
+
+    // We bin the mass and volume (and pressure for GR) of all of the
+    // levels into one buffer, so that a single reduction covers all of
+    // them.  Each level's section holds the mass, then the volume, then
+    // the pressure.
+
 #ifdef GR_GRAV
-            priv_radial_pres[i].resize(n1d,0.0);
+    const int nvar = 3;
+#else
+    const int nvar = 2;
 #endif
-            priv_radial_mass[i].resize(n1d,0.0);
-            priv_radial_vol [i].resize(n1d,0.0);
+
+    Vector<int> offset(level+2, 0);
+    for (int lev = 0; lev <= level; lev++) {
+        offset[lev+1] = offset[lev] + nvar * static_cast<int>(radial_mass[lev].size());
+    }
+
+    const int ntot = offset[level+1];
+
+    RealVector radial_sum(ntot, 0.0_rt);
+
+    for (int lev = 0; lev <= level; lev++)
+    {
+        // Rather than building a time-interpolated copy of the state,
+        // we read the old and new state directly and interpolate the
+        // (few) components we need in compute_radial_mass.
+
+        const MultiFab* S_old = nullptr;
+        const MultiFab* S_new = nullptr;
+        Real alpha = 1.0_rt;
+
+        state_at_time(lev, time, S_old, S_new, alpha);
+
+        const MultiFab* mask = nullptr;
+
+        if (lev < level)
+        {
+            auto* fine_level = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)));
+            if (fine_level != nullptr) {
+                mask = &(fine_level->build_fine_mask());
+            } else {
+                amrex::Abort("unable to create mask");
+            }
+        }
+
+        int n1d = static_cast<int>(radial_mass[lev].size());
+
+#ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+        Vector< RealVector > priv_radial_sum(nthreads);
+        for (int i=0; i<nthreads; i++) {
+            priv_radial_sum[i].resize(nvar*n1d,0.0);
         }
 #pragma omp parallel
 #endif
         {
 #ifdef _OPENMP
-            int tid = omp_get_thread_num();
+            Real* const lev_sum = priv_radial_sum[omp_get_thread_num()].dataPtr();
+#else
+            Real* const lev_sum = radial_sum.dataPtr() + offset[lev];
 #endif
-            for (MFIter mfi(S, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+
+            for (MFIter mfi(*S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
                 const Box& bx = mfi.tilebox();
-                FArrayBox& fab = S[mfi];
 
                 compute_radial_mass(bx,
-                                    fab.array(),
-#ifdef _OPENMP
-                                    priv_radial_mass[tid],
-                                    priv_radial_vol[tid],
+                                    (*S_old)[mfi].const_array(),
+                                    (*S_new)[mfi].const_array(),
+                                    alpha,
+                                    mask != nullptr ? mask->const_array(mfi) : Array4<Real const>{},
+                                    lev_sum,
+                                    lev_sum + n1d,
 #ifdef GR_GRAV
-                                    priv_radial_pres[tid],
-#endif
-#else
-                                    radial_mass[lev],
-                                    radial_vol[lev],
-#ifdef GR_GRAV
-                                    radial_pres[lev],
-#endif
+                                    lev_sum + 2 * n1d,
 #endif
                                     n1d, lev);
             }
@@ -3213,39 +3638,46 @@ Gravity::make_radial_gravity(int level, Real time, RealVector& radial_grav)
 #ifdef _OPENMP
 #pragma omp barrier
 #pragma omp for
-            for (int i=0; i<n1d; i++) {
+            for (int i=0; i<nvar*n1d; i++) {
                 for (int it=0; it<nthreads; it++) {
-#ifdef GR_GRAV
-                    radial_pres[lev][i] += priv_radial_pres[it][i];
-#endif
-                    radial_mass[lev][i] += priv_radial_mass[it][i];
-                    radial_vol [lev][i] += priv_radial_vol [it][i];
+                    radial_sum[offset[lev]+i] += priv_radial_sum[it][i];
                 }
             }
 #endif
         }
+    }
 
-        if (!ParallelDescriptor::UseGpuAwareMpi()) {
-            Gpu::prefetchToHost(radial_mass[lev].begin(), radial_mass[lev].end());
-            Gpu::prefetchToHost(radial_vol[lev].begin(), radial_vol[lev].end());
-#ifdef GR_GRAV
-            Gpu::prefetchToHost(radial_pres[lev].begin(), radial_pres[lev].end());
-#endif
-        }
+    if (!ParallelDescriptor::UseGpuAwareMpi()) {
+        Gpu::prefetchToHost(radial_sum.begin(), radial_sum.end());
+    }
+
+    ParallelDescriptor::ReduceRealSum(radial_sum.dataPtr(), ntot);
+
+    if (!ParallelDescriptor::UseGpuAwareMpi()) {
+        Gpu::prefetchToDevice(radial_sum.begin(), radial_sum.end());
+    }
+
+    for (int lev = 0; lev <= level; lev++)
+    {
+        int n1d = static_cast<int>(radial_mass[lev].size());
+
+        const Real* const lev_sum = radial_sum.dataPtr() + offset[lev];
 
-        ParallelDescriptor::ReduceRealSum(radial_mass[lev].dataPtr() ,n1d);
-        ParallelDescriptor::ReduceRealSum(radial_vol[lev].dataPtr()  ,n1d);
 #ifdef GR_GRAV
-        ParallelDescriptor::ReduceRealSum(radial_pres[lev].dataPtr()  ,n1d);
+        Real* const lev_pres = radial_pres[lev].dataPtr();
 #endif
+        Real* const lev_vol = radial_vol[lev].dataPtr();
+        Real* const lev_mass = radial_mass[lev].dataPtr();
 
-        if (!ParallelDescriptor::UseGpuAwareMpi()) {
-            Gpu::prefetchToDevice(radial_mass[lev].begin(), radial_mass[lev].end());
-            Gpu::prefetchToDevice(radial_vol[lev].begin(), radial_vol[lev].end());
+        amrex::ParallelFor(n1d,
+        [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            lev_mass[i] = lev_sum[i];
+            lev_vol[i] = lev_sum[n1d+i];
 #ifdef GR_GRAV
-            Gpu::prefetchToDevice(radial_pres[lev].begin(), radial_pres[lev].end());
+            lev_pres[i] = lev_sum[2*n1d+i];
 #endif
-        }
+        });
 
         if (do_diag > 0)
         {
@@ -3627,6 +4059,17 @@ Gravity::solve_phi_with_mlmg (int crse_level, int fine_level,
 
     int nlevs = fine_level-crse_level+1;
 
+    // The RHS scaling doesn't depend on the boundary values, so it
+    // overlaps with their global reduction.
+
+    auto scale_rhs = [&] ()
+    {
+        for (int ilev = 0; ilev < nlevs; ++ilev)
+        {
+            rhs[ilev]->mult(Ggravity);
+        }
+    };
+
     if (crse_level == 0 && !(parent->Geom(0).isAllPeriodic()))
     {
         if (gravity::verbose > 1) {
@@ -3635,20 +4078,19 @@ Gravity::solve_phi_with_mlmg (int crse_level, int fine_level,
 
 #if (AMREX_SPACEDIM == 3)
         if ( gravity::direct_sum_bcs ) {
-            fill_direct_sum_BCs(crse_level, fine_level, rhs, *phi[0]);
+            fill_direct_sum_BCs(crse_level, fine_level, rhs, *phi[0], scale_rhs);
         } else {
-            fill_multipole_BCs(crse_level, fine_level, rhs, *phi[0]);
+            fill_multipole_BCs(crse_level, fine_level, rhs, *phi[0], scale_rhs);
         }
 #elif (AMREX_SPACEDIM == 2)
-        fill_multipole_BCs(crse_level, fine_level, rhs, *phi[0]);
+        fill_multipole_BCs(crse_level, fine_level, rhs, *phi[0], scale_rhs);
 #else
-        fill_multipole_BCs(crse_level, fine_level, rhs, *phi[0]);
+        fill_multipole_BCs(crse_level, fine_level, rhs, *phi[0], scale_rhs);
 #endif
     }
-
-    for (int ilev = 0; ilev < nlevs; ++ilev)
+    else
     {
-        rhs[ilev]->mult(Ggravity);
+        scale_rhs();
     }
 
     MultiFab CPhi;
@@ -3726,24 +4168,52 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
 
     int nlevs = fine_level-crse_level+1;
 
-    Vector<Geometry> gmv;
+    const Real strt_setup = ParallelDescriptor::second();
+
     Vector<BoxArray> bav;
     Vector<DistributionMapping> dmv;
     for (int ilev = 0; ilev < nlevs; ++ilev)
     {
-        gmv.push_back(parent->Geom(ilev+crse_level));
         bav.push_back(rhs[ilev]->boxArray());
         dmv.push_back(rhs[ilev]->DistributionMap());
     }
 
-    LPInfo info;
-    info.setAgglomeration(gravity::mlmg_agglomeration);
-    info.setConsolidation(gravity::mlmg_consolidation);
+    // Building the operator hierarchy (the coarsened grids, the
+    // agglomeration/consolidation communicators and the bottom solver
+    // setup) is a large part of the cost of a solve, so we keep the
+    // operator for a given range of levels until the grids change.
+
+    MLPoissonCache& cache = mlpoisson_cache[std::make_pair(crse_level, fine_level)];
+
+    if (!gravity::mlmg_reuse_operator || cache.op == nullptr ||
+        cache.ba != bav || cache.dm != dmv)
+    {
+        Vector<Geometry> gmv;
+        for (int ilev = 0; ilev < nlevs; ++ilev)
+        {
+            gmv.push_back(parent->Geom(ilev+crse_level));
+        }
+
+        LPInfo info;
+        info.setAgglomeration(gravity::mlmg_agglomeration);
+        info.setConsolidation(gravity::mlmg_consolidation);
+
+        cache.op = std::make_unique<MLPoisson>(gmv, bav, dmv, info);
+        cache.ba = bav;
+        cache.dm = dmv;
+
+        cache.op->setDomainBC(mlmg_lobc, mlmg_hibc);
+
+        cache.op_single.reset();
+        if (gravity::mlmg_mixed_precision) {
+            cache.op_single = std::make_unique<MLPoissonT<FloatMultiFab>>(gmv, bav, dmv, info);
+            cache.op_single->setDomainBC(mlmg_lobc, mlmg_hibc);
+        }
+    }
 
-    MLPoisson mlpoisson(gmv, bav, dmv, info);
+    MLPoisson& mlpoisson = *cache.op;
 
     // BC
-    mlpoisson.setDomainBC(mlmg_lobc, mlmg_hibc);
     if (mlpoisson.needsCoarseDataForBC())
     {
         mlpoisson.setCoarseFineBC(crse_bcdata, parent->refRatio(crse_level-1)[0]);
@@ -3765,16 +4235,50 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
     AMREX_ALWAYS_ASSERT( !grad_phi.empty() or !res.empty() );
     AMREX_ALWAYS_ASSERT(  grad_phi.empty() or  res.empty() );
 
+    Real setup_time = ParallelDescriptor::second() - strt_setup;
+
     if (!grad_phi.empty())
     {
-        if (!gmv[0].isAllPeriodic()) {
+        if (!parent->Geom(crse_level).isAllPeriodic()) {
             mlmg.setAlwaysUseBNorm(true);
         }
 
         mlmg.setNSolve(gravity::mlmg_nsolve);
+
+        const Real strt_solve = ParallelDescriptor::second();
+
+        // In mixed precision the single precision corrections do (nearly)
+        // all of the work, and the double precision solve below then only
+        // has to confirm that the tolerance has been reached.
+
+        int num_single_iters = 0;
+        if (cache.op_single != nullptr) {
+            num_single_iters = refine_in_single_precision(mlmg, *cache.op_single, crse_level, fine_level,
+                                                          phi, rhs, rel_eps, abs_eps);
+        }
+
         final_resnorm = mlmg.solve(phi, rhs, rel_eps, abs_eps);
 
         mlmg.getGradSolution(grad_phi);
+
+        Real solve_time = ParallelDescriptor::second() - strt_solve;
+
+        if (gravity::verbose > 1)
+        {
+            const int IOProc = ParallelDescriptor::IOProcessorNumber();
+            const int num_iters = mlmg.getNumIters();
+
+            ParallelDescriptor::ReduceRealMax(setup_time, IOProc);
+            ParallelDescriptor::ReduceRealMax(solve_time, IOProc);
+
+            amrex::Print() << "Gravity MLMG solve from level " << crse_level << " to level " << fine_level
+                           << ": " << num_iters << " iterations";
+            if (cache.op_single != nullptr) {
+                amrex::Print() << " (+ " << num_single_iters << " single precision)";
+            }
+            amrex::Print() << ", setup time = " << setup_time
+                           << ", solve time = " << solve_time << std::endl;
+        }
     }
     else if (!res.empty())
     {
@@ -3783,3 +4287,110 @@ Gravity::actual_solve_with_mlmg (int crse_level, int fine_level,
 
     return final_resnorm;
 }
+
+int
+Gravity::refine_in_single_precision (MLMG& mlmg, MLPoissonT<FloatMultiFab>& mlpoisson_single,
+                                     int crse_level, int fine_level,
+                                     const Vector<MultiFab*>& phi,
+                                     const Vector<const MultiFab*>& rhs,
+                                     Real rel_eps, Real abs_eps) const
+{
+    BL_PROFILE("Gravity::refine_in_single_precision()");
+
+    // Iterative refinement: the residual r = rhs - L(phi), including the
+    // inhomogeneous boundary data, is computed in double precision, and the
+    // correction equation L(e) = r is solved with homogeneous boundary
+    // conditions by V-cycles in single precision, halving the memory
+    // traffic of the smoothing, restriction and prolongation.
+
+    const int nlevs = fine_level - crse_level + 1;
+
+    Vector<MultiFab> res(nlevs);
+    Vector<MultiFab> corr(nlevs);
+    Vector<FloatMultiFab> res_single(nlevs);
+    Vector<FloatMultiFab> corr_single(nlevs);
+
+    for (int ilev = 0; ilev < nlevs; ++ilev)
+    {
+        const BoxArray& ba = rhs[ilev]->boxArray();
+        const DistributionMapping& dm = rhs[ilev]->DistributionMap();
+
+        res[ilev].define(ba, dm, 1, 0);
+        corr[ilev].define(ba, dm, 1, 0);
+        res_single[ilev].define(ba, dm, 1, 0);
+        corr_single[ilev].define(ba, dm, 1, 1);
+    }
+
+    if (mlpoisson_single.needsCoarseDataForBC())
+    {
+        mlpoisson_single.setCoarseFineBC(nullptr, parent->refRatio(crse_level-1)[0]);
+    }
+
+    for (int ilev = 0; ilev < nlevs; ++ilev)
+    {
+        mlpoisson_single.setLevelBC(ilev, nullptr);
+    }
+
+    // Stop once the stopping criterion of MLMG::solve is (roughly) met;
+    // the double precision solve that follows makes the final check.
+
+    const bool use_bnorm = !parent->Geom(crse_level).isAllPeriodic();
+
+    auto norminf = [&] (const auto& mf) -> Real
+    {
+        Real norm = 0.0;
+        for (int ilev = 0; ilev < nlevs; ++ilev) {
+            norm = std::max(norm, mf[ilev]->norminf(0, 0, true));
+        }
+        ParallelDescriptor::ReduceRealMax(norm);
+        return norm;
+    };
+
+    const Real bnorm = use_bnorm ? norminf(rhs) : 0.0;
+
+    int num_iters = 0;
+    Real resnorm0 = -1.0;
+
+    for (int iter = 0; iter < gravity::mlmg_mixed_precision_max_iter; ++iter)
+    {
+        mlmg.compResidual(GetVecOfPtrs(res), phi, rhs);
+
+        const Real resnorm = norminf(GetVecOfPtrs(res));
+
+        if (resnorm0 < 0.0) {
+            resnorm0 = resnorm;
+        }
+
+        const Real target = std::max(abs_eps, rel_eps * (use_bnorm ? bnorm : resnorm0));
+
+        if (resnorm <= target) {
+            break;
+        }
+
+        for (int ilev = 0; ilev < nlevs; ++ilev)
+        {
+            amrex::LocalCopy(res_single[ilev], res[ilev], 0, 0, 1, IntVect(0));
+            corr_single[ilev].setVal(0.0f);
+        }
+
+        MLMGT<FloatMultiFab> mlmg_single(mlpoisson_single);
+        mlmg_single.setVerbose(gravity::verbose - 2);
+        mlmg_single.setMaxFmgIter(0);
+        if (use_bnorm) {
+            mlmg_single.setAlwaysUseBNorm(true);
+        }
+
+        mlmg_single.solve(GetVecOfPtrs(corr_single), GetVecOfConstPtrs(res_single),
+                          static_cast<float>(gravity::mlmg_mixed_precision_rel_tol), 0.0f);
+
+        num_iters += mlmg_single.getNumIters();
+
+        for (int ilev = 0; ilev < nlevs; ++ilev)
+        {
+            amrex::LocalCopy(corr[ilev], corr_single[ilev], 0, 0, 1, IntVect(0));
+            MultiFab::Add(*phi[ilev], corr[ilev], 0, 0, 1, 0);
+        }
+    }
+
+    return num_iters;
+}
@@ -11,8 +11,57 @@
 
 #include <advection_util.H>
 
+#include <algorithm>
+#include <limits>
+
 using namespace amrex;
 
+#ifndef AMREX_USE_GPU
+namespace {
+
+    // the tile shapes we try when autotuning the CPU hydro tile size,
+    // clipped to the largest box on the level so that we don't time
+    // shapes that give the same tiling twice
+
+    Vector<IntVect>
+    hydro_tile_size_candidates (const IntVect& default_tile_size, const IntVect& box_size)
+    {
+        Vector<IntVect> sizes{default_tile_size};
+
+#if AMREX_SPACEDIM == 1
+        for (int t : {32, 64, 256}) {
+            sizes.emplace_back(t);
+        }
+#else
+        // we keep the tiles long in x so the inner loops stay
+        // contiguous and vary the extent in the other directions ...
+        for (int t : {4, 8, 16, 32, 64}) {
+            sizes.emplace_back(AMREX_D_DECL(1024, t, t));
+        }
+
+        // ... but with many species a tile short in x may be needed
+        // to fit the temporaries in cache
+        sizes.emplace_back(AMREX_D_DECL(64, 16, 16));
+        sizes.emplace_back(AMREX_D_DECL(32, 8, 8));
+#endif
+
+        // no tiling at all
+        sizes.emplace_back(1024);
+
+        Vector<IntVect> candidates;
+        for (const auto& size : sizes) {
+            IntVect tile = amrex::min(size, box_size);
+            if (std::find(candidates.begin(), candidates.end(), tile) == candidates.end()) {
+                candidates.push_back(tile);
+            }
+        }
+
+        return candidates;
+    }
+
+}
+#endif
+
 advance_status
 Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-convert-member-functions-to-static)
 {
@@ -125,6 +174,10 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
    }
 #endif
 
+  const IntVect tile_size = ctu_hydro_tile_size();
+
+  const Real tile_strt_time = ParallelDescriptor::second();
+
 #ifdef _OPENMP
 #ifdef RADIATION
 #pragma omp parallel reduction(max:nstep_fsp)
@@ -190,7 +243,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
 
     MultiFab& old_source = get_old_data(Source_Type);
 
-    for (MFIter mfi(S_new, hydro_tile_size); mfi.isValid(); ++mfi) {
+    for (MFIter mfi(S_new, tile_size); mfi.isValid(); ++mfi) {
 
       // the valid region box
       const Box& bx = mfi.tilebox();
@@ -1417,6 +1470,8 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
 
   } // OMP loop
 
+  record_ctu_hydro_tile_time(ParallelDescriptor::second() - tile_strt_time);
+
 #ifdef RADIATION
   if (radiation->verbose>=1) {
       amrex::Real llevel = level;
@@ -1503,3 +1558,112 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)  // NOLINT(readability-co
 
   return status;
 }
+
+
+IntVect
+Castro::ctu_hydro_tile_size()
+{
+#ifdef AMREX_USE_GPU
+    return hydro_tile_size;
+#else
+    if (hydro_tile_size_autotune == 0) {
+        return hydro_tile_size;
+    }
+
+    if (hydro_tile_tuning.size() <= level) {
+        hydro_tile_tuning.resize(level+1);
+    }
+
+    auto& tuning = hydro_tile_tuning[level];
+
+    IntVect box_size{0};
+    for (int i = 0; i < grids.size(); ++i) {
+        box_size = amrex::max(box_size, grids[i].length());
+    }
+
+    if (tuning.tuned == 1) {
+        if (box_size.allLE(tuning.tuned_box_size)) {
+            return tuning.tile_size;
+        }
+
+        // a regrid gave us a bigger box than we tuned for, so start over
+
+        tuning = HydroTileTuning{};
+    }
+
+    if (tuning.candidates.empty()) {
+        tuning.candidates = hydro_tile_size_candidates(hydro_tile_size, box_size);
+        tuning.time_per_zone.resize(tuning.candidates.size(), std::numeric_limits<Real>::max());
+    }
+
+    tuning.tuned_box_size = amrex::max(tuning.tuned_box_size, box_size);
+
+    return tuning.candidates[tuning.candidate];
+#endif
+}
+
+
+void
+Castro::record_ctu_hydro_tile_time(Real elapsed)
+{
+#ifdef AMREX_USE_GPU
+    amrex::ignore_unused(elapsed);
+#else
+    if (hydro_tile_size_autotune == 0 || hydro_tile_tuning[level].tuned == 1) {
+        return;
+    }
+
+    auto& tuning = hydro_tile_tuning[level];
+
+    // the slowest rank sets the pace, and every rank needs to come to
+    // the same decision
+
+    ParallelDescriptor::ReduceRealMax(elapsed);
+
+    // we keep the fastest sample for each candidate -- this filters
+    // out one-time costs like the first touch of the arena memory
+
+    const Real per_zone = elapsed / static_cast<Real>(grids.numPts());
+
+    tuning.time_per_zone[tuning.candidate] = amrex::min(tuning.time_per_zone[tuning.candidate], per_zone);
+
+    tuning.sample++;
+
+    if (tuning.sample < hydro_tile_size_autotune_samples) {
+        return;
+    }
+
+    tuning.sample = 0;
+    tuning.candidate++;
+
+    if (tuning.candidate < tuning.candidates.size()) {
+        return;
+    }
+
+    // every candidate has been timed, so pick the fastest
+
+    int best = 0;
+    for (int n = 1; n < tuning.candidates.size(); ++n) {
+        if (tuning.time_per_zone[n] < tuning.time_per_zone[best]) {
+            best = n;
+        }
+    }
+
+    if (verbose) {
+        for (int n = 0; n < tuning.candidates.size(); ++n) {
+            amrex::Print() << "... hydro tile size " << tuning.candidates[n]
+                           << " on level " << level << ": " << tuning.time_per_zone[n]
+                           << " s per zone" << std::endl;
+        }
+    }
+
+    tuning.tile_size = tuning.candidates[best];
+    tuning.tuned = 1;
+
+    amrex::Print() << "... hydro tile size on level " << level << " tuned to " << tuning.tile_size
+                   << " for boxes up to " << tuning.tuned_box_size << std::endl;
+
+    tuning.candidates.clear();
+    tuning.time_per_zone.clear();
+#endif
+}
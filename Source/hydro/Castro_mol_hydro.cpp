@@ -693,14 +693,44 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
         }
 
 
-        // Store the fluxes from this advance -- we weight them by the
-        // integrator weight for this stage
-
-        // For SDC, we store node 0 the only time we enter here (the
-        // first iteration) and we store the other nodes only on the
-        // last iteration.
-        if (time_integration_method == SpectralDeferredCorrections &&
-             (current_sdc_node == 0 || sdc_iteration == sdc_order+sdc_extra-1)) {
+        // Store the fluxes from this advance.  With AMR, we keep the
+        // fluxes for each node, and do_advance_sdc combines them into
+        // the time-integrated fluxes that match the update.
+        if (time_integration_method == SpectralDeferredCorrections && !sdc_node_fluxes.empty()) {
+
+          for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+
+            Array4<Real> const flux_fab = (flux[idir]).array();
+            Array4<Real> node_flux_fab = (*sdc_node_fluxes[current_sdc_node][idir]).array(mfi);
+            const int numcomp = NUM_STATE;
+
+            AMREX_HOST_DEVICE_FOR_4D(mfi.nodaltilebox(idir), numcomp, i, j, k, n,
+            {
+                node_flux_fab(i,j,k,n) = flux_fab(i,j,k,n);
+            });
+
+          }
+
+#if AMREX_SPACEDIM <= 2
+          if (!Geom().IsCartesian()) {
+
+            Array4<Real> node_P_radial_fab = (*sdc_node_P_radial[current_sdc_node]).array(mfi);
+
+            AMREX_HOST_DEVICE_FOR_4D(mfi.nodaltilebox(0), 1, i, j, k, n,
+            {
+                node_P_radial_fab(i,j,k,0) = pradial_fab(i,j,k,0);
+            });
+
+          }
+#endif
+
+        } else if (time_integration_method == SpectralDeferredCorrections &&
+                   (current_sdc_node == 0 || sdc_iteration == sdc_order+sdc_extra-1)) {
+
+          // Otherwise we weight them by the integrator weight for this
+          // stage.  We store node 0 the only time we enter here (the
+          // first iteration) and we store the other nodes only on the
+          // last iteration.
 
           for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
 
@@ -2,6 +2,9 @@
 
 #include <riemann_solvers.H>
 #include <HLL_solvers.H>
+#ifdef RIEMANN_BATCH
+#include <riemann_batch.H>
+#endif
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -12,6 +15,112 @@
 #include <eos.H>
 using namespace amrex;
 
+namespace {
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void
+    upwind_passives(const int i, const int j, const int k,
+                    const RiemannState& qint,
+                    Array4<Real> const& qm,
+                    Array4<Real> const& qp,
+                    Array4<Real> const& flx,
+                    Array4<Real> const& qgdnv,
+                    const bool store_full_state) {
+
+        // the passives are always just upwinded, so we do that here
+        // regardless of the solver
+
+        Real sgnm = std::copysign(1.0_rt, qint.un);
+        if (qint.un == 0.0_rt) {
+            sgnm = 0.0_rt;
+        }
+
+        Real fp = 0.5_rt*(1.0_rt + sgnm);
+        Real fm = 0.5_rt*(1.0_rt - sgnm);
+
+        for (int ipassive = 0; ipassive < npassive; ipassive++) {
+            int nqp = qpassmap(ipassive);
+            int n  = upassmap(ipassive);
+
+            Real X_int = fp * qm(i,j,k,nqp) + fm * qp(i,j,k,nqp);
+
+            flx(i,j,k,n) = flx(i,j,k,URHO) * X_int;
+
+            if (store_full_state) {
+                qgdnv(i,j,k,nqp) = X_int;
+            }
+        }
+
+    }
+
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void
+    hybrid_hll_correction(const int i, const int j, const int k, const int idir,
+                          const int coord,
+                          Array4<Real> const& qm,
+                          Array4<Real> const& qp,
+                          Array4<Real> const& flx,
+                          Array4<Real const> const& qaux_arr,
+                          Array4<Real const> const& shk) {
+
+        // correct the fluxes using an HLL scheme if we are in a shock
+        // and doing the hybrid approach
+
+        int is_shock = 0;
+
+        if (idir == 0) {
+            is_shock = static_cast<int>(shk(i-1,j,k) + shk(i,j,k));
+        } else if (idir == 1) {
+            is_shock = static_cast<int>(shk(i,j-1,k) + shk(i,j,k));
+        } else {
+            is_shock = static_cast<int>(shk(i,j,k-1) + shk(i,j,k));
+        }
+
+        if (is_shock >= 1) {
+
+            Real cl;
+            Real cr;
+            if (idir == 0) {
+                cl = qaux_arr(i-1,j,k,QC);
+                cr = qaux_arr(i,j,k,QC);
+            } else if (idir == 1) {
+                cl = qaux_arr(i,j-1,k,QC);
+                cr = qaux_arr(i,j,k,QC);
+            } else {
+                cl = qaux_arr(i,j,k-1,QC);
+                cr = qaux_arr(i,j,k,QC);
+            }
+
+            Real ql_zone[NQ];
+            Real qr_zone[NQ];
+            Real flx_zone[NUM_STATE];
+
+            for (int n = 0; n < NQ; n++) {
+                ql_zone[n] = qm(i,j,k,n);
+                qr_zone[n] = qp(i,j,k,n);
+            }
+
+            // pass in the current flux -- the
+            // HLL solver will overwrite this
+            // if necessary
+            for (int n = 0; n < NUM_STATE; n++) {
+                flx_zone[n] = flx(i,j,k,n);
+            }
+
+            HLL::HLL(ql_zone, qr_zone, cl, cr,
+                     idir, coord,
+                     flx_zone);
+
+            for (int n = 0; n < NUM_STATE; n++) {
+                flx(i,j,k,n) = flx_zone[n];
+            }
+        }
+
+    }
+
+}
+
 void
 Castro::cmpflx_plus_godunov(const Box& bx,
                             Array4<Real> const& qm,
@@ -66,6 +175,64 @@ Castro::cmpflx_plus_godunov(const Box& bx,
     const auto domlo = geom.Domain().loVect3d();
     const auto domhi = geom.Domain().hiVect3d();
 
+#if defined(RIEMANN_BATCH) && !defined(AMREX_USE_GPU) && !defined(RADIATION)
+    if (riemann_solver == 0 || riemann_solver == 1) {
+
+        // On CPUs we solve the Riemann problems for a whole row of
+        // interfaces at once.  We gather the input states along the
+        // contiguous (x) index, solve them as a batch, and then compute
+        // the fluxes zone by zone as usual.  The interfaces are
+        // independent, so this works for any idir.
+
+        const auto lo = amrex::lbound(bx);
+        const auto hi = amrex::ubound(bx);
+        const int nx = hi.x - lo.x + 1;
+
+        Vector<RiemannState> ql(nx);
+        Vector<RiemannState> qr(nx);
+        Vector<RiemannAux> raux(nx);
+        Vector<RiemannState> qint(nx);
+
+        for (int k = lo.z; k <= hi.z; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+
+                for (int i = lo.x; i <= hi.x; ++i) {
+                    riemann_input_states(i, j, k, idir,
+                                         qm, qp, qaux_arr,
+                                         ql[i-lo.x], qr[i-lo.x], raux[i-lo.x],
+                                         special_bnd_lo, special_bnd_hi,
+                                         domlo, domhi);
+                }
+
+                if (riemann_solver == 0) {
+                    RiemannBatch::riemannus(ql.data(), qr.data(), raux.data(), qint.data(), nx);
+                } else {
+                    RiemannBatch::riemanncg(ql.data(), qr.data(), raux.data(), qint.data(), nx);
+                }
+
+                for (int i = lo.x; i <= hi.x; ++i) {
+
+                    compute_flux_q(i, j, k, idir,
+                                   geomdata,
+                                   qint[i-lo.x], flx,
+                                   qgdnv, store_full_state);
+
+                    upwind_passives(i, j, k, qint[i-lo.x],
+                                    qm, qp, flx, qgdnv, store_full_state);
+
+                    if (hybrid_riemann == 1) {
+                        hybrid_hll_correction(i, j, k, idir, coord,
+                                              qm, qp, flx, qaux_arr, shk);
+                    }
+                }
+
+            }
+        }
+
+        return;
+    }
+#endif
+
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
@@ -96,29 +263,8 @@ Castro::cmpflx_plus_godunov(const Box& bx,
 
             // now do the passives -- we didn't include them in qint, qgdnv, or flux above
 
-            // the passives are always just upwinded, so we do that here
-            // regardless of the solver
-
-            Real sgnm = std::copysign(1.0_rt, qint.un);
-            if (qint.un == 0.0_rt) {
-                sgnm = 0.0_rt;
-            }
-
-            Real fp = 0.5_rt*(1.0_rt + sgnm);
-            Real fm = 0.5_rt*(1.0_rt - sgnm);
-
-            for (int ipassive = 0; ipassive < npassive; ipassive++) {
-                int nqp = qpassmap(ipassive);
-                int n  = upassmap(ipassive);
-
-                Real X_int = fp * qm(i,j,k,nqp) + fm * qp(i,j,k,nqp);
-
-                flx(i,j,k,n) = flx(i,j,k,URHO) * X_int;
-
-                if (store_full_state) {
-                    qgdnv(i,j,k,nqp) = X_int;
-                }
-            }
+            upwind_passives(i, j, k, qint,
+                            qm, qp, flx, qgdnv, store_full_state);
 
         } else if (riemann_solver == 2) {
             // HLLC
@@ -138,58 +284,8 @@ Castro::cmpflx_plus_godunov(const Box& bx,
         }
 
         if (hybrid_riemann == 1) {
-            // correct the fluxes using an HLL scheme if we are in a shock
-            // and doing the hybrid approach
-
-            int is_shock = 0;
-
-            if (idir == 0) {
-                is_shock = static_cast<int>(shk(i-1,j,k) + shk(i,j,k));
-            } else if (idir == 1) {
-                is_shock = static_cast<int>(shk(i,j-1,k) + shk(i,j,k));
-            } else {
-                is_shock = static_cast<int>(shk(i,j,k-1) + shk(i,j,k));
-            }
-
-            if (is_shock >= 1) {
-
-                Real cl;
-                Real cr;
-                if (idir == 0) {
-                    cl = qaux_arr(i-1,j,k,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                } else if (idir == 1) {
-                    cl = qaux_arr(i,j-1,k,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                } else {
-                    cl = qaux_arr(i,j,k-1,QC);
-                    cr = qaux_arr(i,j,k,QC);
-                }
-
-                Real ql_zone[NQ];
-                Real qr_zone[NQ];
-                Real flx_zone[NUM_STATE];
-
-                for (int n = 0; n < NQ; n++) {
-                    ql_zone[n] = qm(i,j,k,n);
-                    qr_zone[n] = qp(i,j,k,n);
-                }
-
-                // pass in the current flux -- the
-                // HLL solver will overwrite this
-                // if necessary
-                for (int n = 0; n < NUM_STATE; n++) {
-                    flx_zone[n] = flx(i,j,k,n);
-                }
-
-                HLL::HLL(ql_zone, qr_zone, cl, cr,
-                         idir, coord,
-                         flx_zone);
-
-                for (int n = 0; n < NUM_STATE; n++) {
-                    flx(i,j,k,n) = flx_zone[n];
-                }
-            }
+            hybrid_hll_correction(i, j, k, idir, coord,
+                                  qm, qp, flx, qaux_arr, shk);
         }
     });
 
@@ -28,14 +28,6 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
       MultiFab& old_source = get_old_data(Source_Type);
 
 
-      //MultiFab electric[AMREX_SPACEDIM];
-      //for (int j = 0; j < AMREX_SPACEDIM; j++)
-      //{
-      //  electric[j].define(getEdgeBoxArray(j), dmap, 1, 0);
-      //  electric[j].setVal(0.0);
-      //}
-
-
       BL_ASSERT(NUM_GROW == 6);
 
 
@@ -675,13 +667,9 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
           });
 
 
-          // not sure if this is needed
-
-          //Ex(ex_lo(1):ex_hi(1),ex_lo(2):ex_hi(2), ex_lo(3):ex_hi(3)) = Extemp(ex_lo(1):ex_hi(1),ex_lo(2):ex_hi(2),ex_lo(3):ex_hi(3))
-          //Ey(ey_lo(1):ey_hi(1),ey_lo(2):ey_hi(2), ey_lo(3):ey_hi(3)) = Eytemp(ey_lo(1):ey_hi(1),ey_lo(2):ey_hi(2),ey_lo(3):ey_hi(3))
-          //Ez(ez_lo(1):ez_hi(1),ez_lo(2):ez_hi(2), ez_lo(3):ez_hi(3)) = Eztemp(ez_lo(1):ez_hi(1),ez_lo(2):ez_hi(2),ez_lo(3):ez_hi(3))
-
-          // Store the fluxes from this advance.
+          // Store the fluxes from this advance, scaled by the face area
+          // and dt, as the CTU hydro does (the flux registers and the
+          // gravity and rotation sources expect them this way).
 
           // For normal integration we want to add the fluxes from this advance
           // since we may be subcycling the timestep. But for simplified SDC integration
@@ -692,20 +680,21 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
             Array4<Real> const flux_fab = (flux[idir]).array();
             Array4<Real> fluxes_fab = (*fluxes[idir]).array(mfi);
+            Array4<Real const> const area_arr = (area[idir]).array(mfi);
             const int numcomp = NUM_STATE;
 
             if (time_integration_method == SimplifiedSpectralDeferredCorrections) {
 
               AMREX_HOST_DEVICE_FOR_4D(mfi.nodaltilebox(idir), numcomp, i, j, k, n,
               {
-                fluxes_fab(i,j,k,n) = flux_fab(i,j,k,n);
+                fluxes_fab(i,j,k,n) = dt * area_arr(i,j,k) * flux_fab(i,j,k,n);
               });
 
             } else {
 
               AMREX_HOST_DEVICE_FOR_4D(mfi.nodaltilebox(idir), numcomp, i, j, k, n,
               {
-                fluxes_fab(i,j,k,n) += flux_fab(i,j,k,n);
+                fluxes_fab(i,j,k,n) += dt * area_arr(i,j,k) * flux_fab(i,j,k,n);
               });
 
             }
@@ -715,11 +704,42 @@ Castro::construct_ctu_mhd_source(Real time, Real dt)
 
             AMREX_HOST_DEVICE_FOR_4D(mfi.nodaltilebox(idir), 1, i, j, k, n,
             {
-              mass_fluxes_fab(i,j,k,0) = flux_fab(i,j,k,URHO);
+              mass_fluxes_fab(i,j,k,0) = dt * area_arr(i,j,k) * flux_fab(i,j,k,URHO);
             });
 
           } // idir loop
 
+          // Store the edge electric fields for the EMF flux register in
+          // the same way.  The edge box of this tile is the tile box made
+          // nodal in the two directions transverse to the edge.
+
+          for (int idir = 0; idir < 3; idir++) {
+
+            Array4<Real const> const E_fab = (E[idir]).const_array();
+            Array4<Real> electric_fab = (*electric[idir]).array(mfi);
+
+            const Box& ebx = mfi.tilebox(IntVect::TheNodeVector() - IntVect::TheDimensionVector(idir));
+
+            if (time_integration_method == SimplifiedSpectralDeferredCorrections) {
+
+              amrex::ParallelFor(ebx,
+              [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+              {
+                electric_fab(i,j,k) = dt * E_fab(i,j,k);
+              });
+
+            } else {
+
+              amrex::ParallelFor(ebx,
+              [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+              {
+                electric_fab(i,j,k) += dt * E_fab(i,j,k);
+              });
+
+            }
+
+          }
+
         }
 
     }
@@ -2,6 +2,9 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <array>
+#include <cstdint>
+#include <fstream>
 #include <Castro.H>
 
 #include <particles_params.H>
@@ -18,6 +21,279 @@ namespace {
     std::vector<int>  timestamp_indices;
     //
     const std::string chk_tracer_particle_file("Tracer");
+
+    // Cloud-in-cell weights of the 2^dim cells around a particle: the
+    // cells are lo + {0,1} in each direction, with weights w[dir][0,1].
+
+    template <typename P>
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    void cic_weights (const P& p,
+                      GpuArray<Real, AMREX_SPACEDIM> const& plo,
+                      GpuArray<Real, AMREX_SPACEDIM> const& dxi,
+                      int* lo, Real (*w)[2])
+    {
+        for (int d = 0; d < 3; ++d) {
+            lo[d] = 0;
+            w[d][0] = 1.0_rt;
+            w[d][1] = 0.0_rt;
+        }
+
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            const Real l = (p.pos(d) - plo[d]) * dxi[d] + 0.5_rt;
+            const int il = static_cast<int>(amrex::Math::floor(l));
+            lo[d] = il - 1;
+            w[d][0] = 1.0_rt - (l - il);
+            w[d][1] = l - il;
+        }
+    }
+
+    constexpr int cic_nj = (AMREX_SPACEDIM >= 2) ? 2 : 1;
+    constexpr int cic_nk = (AMREX_SPACEDIM == 3) ? 2 : 1;
+
+    // Cloud-in-cell interpolation of the velocity from the density and
+    // momenta of the conserved state.
+
+    template <typename P>
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    void cic_state_velocity (const P& p,
+                             GpuArray<Real, AMREX_SPACEDIM> const& plo,
+                             GpuArray<Real, AMREX_SPACEDIM> const& dxi,
+                             Array4<Real const> const& S,
+                             Real* vel)
+    {
+        int lo[3];
+        Real w[3][2];
+        cic_weights(p, plo, dxi, lo, w);
+
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            vel[d] = 0.0_rt;
+        }
+
+        for (int kk = 0; kk < cic_nk; ++kk) {
+            for (int jj = 0; jj < cic_nj; ++jj) {
+                for (int ii = 0; ii < 2; ++ii) {
+                    const int i = lo[0] + ii;
+                    const int j = lo[1] + jj;
+                    const int k = lo[2] + kk;
+
+                    const Real wt = w[0][ii] * w[1][jj] * w[2][kk] / S(i,j,k,URHO);
+
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                        vel[d] += wt * S(i,j,k,UMX+d);
+                    }
+                }
+            }
+        }
+    }
+
+    // Cloud-in-cell interpolation of the state components comps[0:ncomp].
+
+    template <typename P>
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    void cic_state_fields (const P& p,
+                           GpuArray<Real, AMREX_SPACEDIM> const& plo,
+                           GpuArray<Real, AMREX_SPACEDIM> const& dxi,
+                           Array4<Real const> const& S,
+                           const int* comps, int ncomp, Real* vals)
+    {
+        int lo[3];
+        Real w[3][2];
+        cic_weights(p, plo, dxi, lo, w);
+
+        for (int n = 0; n < ncomp; ++n) {
+            vals[n] = 0.0_rt;
+        }
+
+        for (int kk = 0; kk < cic_nk; ++kk) {
+            for (int jj = 0; jj < cic_nj; ++jj) {
+                for (int ii = 0; ii < 2; ++ii) {
+                    const Real wt = w[0][ii] * w[1][jj] * w[2][kk];
+                    for (int n = 0; n < ncomp; ++n) {
+                        vals[n] += wt * S(lo[0]+ii, lo[1]+jj, lo[2]+kk, comps[n]);
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // Tracer histories for the binary timestamp output, kept by column
+    // until they are flushed.
+    //
+    struct TimestampBuffer
+    {
+        std::vector<Long> id;
+        std::vector<int> cpu;
+        std::vector<double> time;
+        std::array<std::vector<double>, AMREX_SPACEDIM> pos;
+        std::vector<std::vector<double>> fields;
+
+        std::size_t size () const { return time.size(); }
+
+        void clear ()
+        {
+            id.clear();
+            cpu.clear();
+            time.clear();
+            for (auto& x : pos) {
+                x.clear();
+            }
+            for (auto& f : fields) {
+                f.clear();
+            }
+        }
+    };
+
+    TimestampBuffer timestamp_buffer;
+    std::string timestamp_binary_file;
+    std::vector<std::string> timestamp_names;
+
+    template <typename T>
+    void write_column (std::ofstream& ofs, const std::vector<T>& v)
+    {
+        ofs.write(reinterpret_cast<const char*>(v.data()),
+                  static_cast<std::streamsize>(v.size() * sizeof(T)));
+    }
+
+    //
+    // Append the buffered records to this rank's binary timestamp file.
+    // A new file starts with a header describing the columns; every flush
+    // then adds one chunk holding the record count followed by the
+    // columns (id, cpu, time, position, fields) one after another.
+    //
+    void flush_timestamp_buffer ()
+    {
+        if (timestamp_buffer.size() == 0 || timestamp_binary_file.empty()) {
+            return;
+        }
+
+        BL_PROFILE("flush_timestamp_buffer()");
+
+        bool new_file = true;
+        {
+            std::ifstream ifs(timestamp_binary_file, std::ios::in | std::ios::binary | std::ios::ate);
+            if (ifs.good() && ifs.tellg() > 0) {
+                new_file = false;
+            }
+        }
+
+        std::ofstream ofs(timestamp_binary_file, std::ios::out | std::ios::app | std::ios::binary);
+        if (!ofs.good()) {
+            amrex::FileOpenFailed(timestamp_binary_file);
+        }
+
+        if (new_file) {
+            const char magic[8] = {'C', 'T', 'R', 'A', 'C', 'E', 'R', '1'};
+            ofs.write(magic, sizeof(magic));
+
+            const std::int32_t ndim = AMREX_SPACEDIM;
+            const auto nfields = static_cast<std::int32_t>(timestamp_indices.size());
+            ofs.write(reinterpret_cast<const char*>(&ndim), sizeof(ndim));
+            ofs.write(reinterpret_cast<const char*>(&nfields), sizeof(nfields));
+
+            for (std::size_t n = 0; n < timestamp_indices.size(); ++n) {
+                const auto idx = static_cast<std::int32_t>(timestamp_indices[n]);
+                const auto len = static_cast<std::int32_t>(timestamp_names[n].size());
+                ofs.write(reinterpret_cast<const char*>(&idx), sizeof(idx));
+                ofs.write(reinterpret_cast<const char*>(&len), sizeof(len));
+                ofs.write(timestamp_names[n].data(), len);
+            }
+        }
+
+        const auto nrec = static_cast<std::int64_t>(timestamp_buffer.size());
+        ofs.write(reinterpret_cast<const char*>(&nrec), sizeof(nrec));
+
+        write_column(ofs, timestamp_buffer.id);
+        write_column(ofs, timestamp_buffer.cpu);
+        write_column(ofs, timestamp_buffer.time);
+        for (const auto& x : timestamp_buffer.pos) {
+            write_column(ofs, x);
+        }
+        for (const auto& f : timestamp_buffer.fields) {
+            write_column(ofs, f);
+        }
+
+        ofs.close();
+        if (ofs.fail()) {
+            amrex::Error("flush_timestamp_buffer: failed writing " + timestamp_binary_file);
+        }
+
+        timestamp_buffer.clear();
+    }
+
+    //
+    // Add a record for every particle on level lev to the buffer, with
+    // the timestamp fields interpolated from S.
+    //
+    void buffer_timestamps (AmrTracerParticleContainer& pc, int lev,
+                            const MultiFab& S, const Geometry& geom, Real time)
+    {
+        BL_PROFILE("buffer_timestamps()");
+
+        using ParticleType = AmrTracerParticleContainer::ParticleType;
+
+        const auto plo = geom.ProbLoArray();
+        const auto dxi = geom.InvCellSizeArray();
+
+        const int nfields = static_cast<int>(timestamp_indices.size());
+
+        Gpu::DeviceVector<int> comps_d(nfields);
+        Gpu::copy(Gpu::hostToDevice, timestamp_indices.begin(), timestamp_indices.end(), comps_d.begin());
+        const int* comps = comps_d.data();
+
+        timestamp_buffer.fields.resize(nfields);
+
+        for (AmrTracerParticleContainer::ParIterType pti(pc, lev); pti.isValid(); ++pti)
+        {
+            auto& aos = pti.GetArrayOfStructs();
+            const auto* pstruct = aos().dataPtr();
+            const int np = static_cast<int>(aos.numParticles());
+
+            if (np == 0) {
+                continue;
+            }
+
+            Gpu::DeviceVector<Real> vals_d(static_cast<std::size_t>(np) * nfields);
+
+            if (nfields > 0) {
+                const auto Sarr = S.const_array(pti);
+                Real* vals = vals_d.data();
+
+                amrex::ParallelFor(np,
+                [=] AMREX_GPU_DEVICE (int n) noexcept
+                {
+                    const auto& p = pstruct[n];
+                    if (p.id() <= 0) {
+                        return;
+                    }
+                    cic_state_fields(p, plo, dxi, Sarr, comps, nfields, vals + n * nfields);
+                });
+            }
+
+            Gpu::HostVector<ParticleType> parts(np);
+            Gpu::HostVector<Real> vals(vals_d.size());
+            Gpu::copyAsync(Gpu::deviceToHost, aos().begin(), aos().begin() + np, parts.begin());
+            Gpu::copyAsync(Gpu::deviceToHost, vals_d.begin(), vals_d.end(), vals.begin());
+            Gpu::streamSynchronize();
+
+            for (int n = 0; n < np; ++n) {
+                const auto& p = parts[n];
+                if (p.id() <= 0) {
+                    continue;
+                }
+
+                timestamp_buffer.id.push_back(p.id());
+                timestamp_buffer.cpu.push_back(p.cpu());
+                timestamp_buffer.time.push_back(time);
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    timestamp_buffer.pos[d].push_back(p.pos(d));
+                }
+                for (int m = 0; m < nfields; ++m) {
+                    timestamp_buffer.fields[m].push_back(vals[static_cast<std::size_t>(n) * nfields + m]);
+                }
+            }
+        }
+    }
 }
 
 void
@@ -65,6 +341,13 @@ Castro::ParticleCheckPoint(const std::string& dir)
     {
         if (TracerPC)
             TracerPC->Checkpoint(dir, chk_tracer_particle_file);
+
+        // Make sure everything up to the checkpoint is on disk, so a
+        // restart does not lose any of the tracer history.  Records
+        // flushed after the checkpoint are still in the files, and a
+        // restarted run writes them again; the reader,
+        // Util/scripts/tracer_timestamps.py, drops those duplicates.
+        FlushParticleTimestamps();
     }
 }
 
@@ -213,6 +496,10 @@ Castro::TimestampParticles (int ngrow)
         if (!timestamp_indices.empty()) {
             imax = *(std::max_element(timestamp_indices.begin(), timestamp_indices.end()));
         }
+
+        for (int idx : timestamp_indices) {
+            timestamp_names.push_back(desc_lst[State_Type].name(idx));
+        }
     }
 
     if ( TracerPC && !particles::timestamp_dir.empty())
@@ -223,6 +510,10 @@ Castro::TimestampParticles (int ngrow)
 
         basename += "Timestamp";
 
+        if (particles::timestamp_binary) {
+            timestamp_binary_file = amrex::Concatenate(basename + "_bin_", ParallelDescriptor::MyProc(), 5);
+        }
+
         int finest_level = parent->finestLevel();
         Real time        = state[State_Type].curTime();
 
@@ -237,14 +528,33 @@ Castro::TimestampParticles (int ngrow)
                 FillPatchIterator fpi(parent->getLevel(lev), S_new,
                                       ng, time, State_Type, 0, imax+1);
                 const MultiFab& S = fpi.get_mf();
-                TracerPC->Timestamp(basename, S    , lev, time, timestamp_indices);
+                if (particles::timestamp_binary) {
+                    buffer_timestamps(*TracerPC, lev, S, parent->Geom(lev), time);
+                } else {
+                    TracerPC->Timestamp(basename, S    , lev, time, timestamp_indices);
+                }
             } else {
-                TracerPC->Timestamp(basename, S_new, lev, time, timestamp_indices);
+                if (particles::timestamp_binary) {
+                    buffer_timestamps(*TracerPC, lev, S_new, parent->Geom(lev), time);
+                } else {
+                    TracerPC->Timestamp(basename, S_new, lev, time, timestamp_indices);
+                }
             }
         }
+
+        if (particles::timestamp_binary &&
+            timestamp_buffer.size() >= static_cast<std::size_t>(particles::timestamp_buffer_size)) {
+            flush_timestamp_buffer();
+        }
     }
 }
 
+void
+Castro::FlushParticleTimestamps ()
+{
+    flush_timestamp_buffer();
+}
+
 #endif
 
 void
@@ -252,29 +562,173 @@ Castro::advance_particles(int iteration, Real time, Real dt)
 {
     if (TracerPC)
     {
-        int ng = iteration;
-        Real t = time + 0.5*dt;
+        BL_PROFILE("Castro::advance_particles()");
 
-        MultiFab Ucc(grids,dmap,AMREX_SPACEDIM,ng); // cell centered velocity
+        const Real strt_time = ParallelDescriptor::second();
 
+        // Sborder is only kept past the end of the advance for the
+        // direct push with CTU and simplified SDC; the true SDC
+        // integrator uses the FillPatch at the half time.  If the step
+        // was retried with subcycles, Sborder holds the state at the
+        // start of the last subcycle rather than at time, so we use the
+        // FillPatch then too.
+
+        const bool use_state = particles::advect_method != 0 && Sborder.ok() &&
+                               (time_integration_method == CornerTransportUpwind ||
+                                time_integration_method == SimplifiedSpectralDeferredCorrections) &&
+                               num_subcycles_taken == 1;
+
+        if (particles::advect_method != 0 && particles::particle_verbose && num_subcycles_taken > 1) {
+            amrex::Print() << "... step on level " << level << " took " << num_subcycles_taken
+                           << " subcycles, advecting particles with the FillPatch velocity" << std::endl;
+        }
+
+        if (use_state)
         {
-            FillPatchIterator fpi(*this, Ucc, ng, t, State_Type, 0, AMREX_SPACEDIM+1);
-            MultiFab& S = fpi.get_mf();
+            advect_particles_with_state(dt);
+
+            Sborder.clear();
+        }
+        else
+        {
+            int ng = iteration;
+            Real t = time + 0.5*dt;
+
+            MultiFab Ucc(grids,dmap,AMREX_SPACEDIM,ng); // cell centered velocity
+
+            {
+                FillPatchIterator fpi(*this, Ucc, ng, t, State_Type, 0, AMREX_SPACEDIM+1);
+                MultiFab& S = fpi.get_mf();
 
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-            for (MFIter mfi(Ucc,true); mfi.isValid(); ++mfi)
-            {
-                const Box& bx = mfi.growntilebox();
-                S[mfi].invert(1.0, bx, 0, 1);
-                for (int dir=0; dir < AMREX_SPACEDIM; ++dir) {
-                    Ucc[mfi].copy(S[mfi], bx, dir+1, bx, dir, 1);
-                    Ucc[mfi].mult(S[mfi], bx, 0, dir);
+                for (MFIter mfi(Ucc,true); mfi.isValid(); ++mfi)
+                {
+                    const Box& bx = mfi.growntilebox();
+                    S[mfi].invert(1.0, bx, 0, 1);
+                    for (int dir=0; dir < AMREX_SPACEDIM; ++dir) {
+                        Ucc[mfi].copy(S[mfi], bx, dir+1, bx, dir, 1);
+                        Ucc[mfi].mult(S[mfi], bx, 0, dir);
+                    }
                 }
             }
+
+            TracerPC->AdvectWithUcc(Ucc, level, dt);
+
+            if (particles::advect_method != 0) {
+                Sborder.clear();
+            }
         }
 
-        TracerPC->AdvectWithUcc(Ucc, level, dt);
+        if (particles::particle_verbose)
+        {
+            const int IOProc = ParallelDescriptor::IOProcessorNumber();
+            Real run_time = ParallelDescriptor::second() - strt_time;
+
+#ifdef BL_LAZY
+            Lazy::QueueReduction( [=] () mutable {
+#endif
+            ParallelDescriptor::ReduceRealMax(run_time, IOProc);
+            amrex::Print() << "Castro::advance_particles() time = " << run_time
+                           << " on level " << level << " (advect_method = "
+                           << (use_state ? particles::advect_method : 0) << ")" << std::endl;
+#ifdef BL_LAZY
+            });
+#endif
+        }
+    }
+}
+
+void
+Castro::advect_particles_with_state (Real dt)
+{
+    BL_PROFILE("Castro::advect_particles_with_state()");
+
+    // Sborder is the old-time state with its ghost zones filled (it
+    // has seen the first half of the burn, which changes neither the
+    // density nor the momenta), so we interpolate the velocity
+    // straight from it.
+
+    AMREX_ALWAYS_ASSERT(Sborder.nGrow() >= 1);
+    AMREX_ALWAYS_ASSERT(TracerPC->OnSameGrids(level, Sborder));
+
+    const auto plo = geom.ProbLoArray();
+    const auto dxi = geom.InvCellSizeArray();
+
+    const int nstages = (particles::advect_method == 2) ? 2 : 1;
+
+    for (int stage = 0; stage < nstages; ++stage)
+    {
+        if (stage == 1)
+        {
+            // The corrector uses the time-centered velocity, so average
+            // the new-time density and momenta into Sborder. The ghost
+            // zones that overlap grids on this level are updated too; the
+            // ones at physical and coarse-fine boundaries keep the old-time
+            // state.
+
+            const MultiFab& S_new = get_new_data(State_Type);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(Sborder, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.tilebox();
+
+                auto S = Sborder.array(mfi);
+                auto Sn = S_new.const_array(mfi);
+
+                amrex::ParallelFor(bx, AMREX_SPACEDIM + 1,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    S(i,j,k,URHO+n) = 0.5_rt * (S(i,j,k,URHO+n) + Sn(i,j,k,URHO+n));
+                });
+            }
+
+            Sborder.FillBoundary(URHO, AMREX_SPACEDIM + 1, geom.periodicity());
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (AmrTracerParticleContainer::ParIterType pti(*TracerPC, level); pti.isValid(); ++pti)
+        {
+            auto& aos = pti.GetArrayOfStructs();
+            auto* pstruct = aos().dataPtr();
+            const int np = static_cast<int>(aos.numParticles());
+
+            const auto S = Sborder.const_array(pti);
+
+            amrex::ParallelFor(np,
+            [=] AMREX_GPU_DEVICE (int n) noexcept
+            {
+                auto& p = pstruct[n];
+
+                if (p.id() <= 0) {
+                    return;
+                }
+
+                Real vel[AMREX_SPACEDIM];
+                cic_state_velocity(p, plo, dxi, S, vel);
+
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    if (nstages == 1) {
+                        // forward Euler with the old-time velocity
+                        p.pos(d) += dt * vel[d];
+                        p.rdata(d) = vel[d];
+                    } else if (stage == 0) {
+                        // predictor: half step to the midpoint, keeping the starting position
+                        p.rdata(d) = p.pos(d);
+                        p.pos(d) += 0.5_rt * dt * vel[d];
+                    } else {
+                        // corrector: full step with the velocity at the midpoint
+                        p.pos(d) = p.rdata(d) + dt * vel[d];
+                        p.rdata(d) = vel[d];
+                    }
+                }
+            });
+        }
     }
 }
@@ -1,10 +1,294 @@
+#include <array>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <memory>
+
 #include <AMReX_BLFort.H>
 #include <Castro.H>
+#include <Castro_bc_fill_nd.H>
 #include <runtime_parameters.H>
 #include <ext_bc_types.H>
 
 using namespace amrex;
 
+namespace {
+
+    // The HSE profile in a column of ghost zones only depends on the
+    // state in the first interior zone of that column (and the second,
+    // if we interpolate the temperature), so we keep the last profile
+    // computed for every column.  A fill that sees the same interior
+    // state to within roundoff copies the profile instead of doing the
+    // Newton iterations with the EOS.
+
+    // interior density, temperature, next interior temperature,
+    // mass fractions and auxiliary quantities
+
+    constexpr int HSE_NKEY = 3 + NumSpec + NumAux;
+
+    // density, temperature, pressure and specific internal energy in each ghost zone
+
+    constexpr int HSE_NPROF = 4;
+
+    // the deepest profile we store
+
+    constexpr int HSE_MAX_ZONES = 8;
+
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void hse_cache_fence ()
+    {
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+        AMREX_IF_ON_DEVICE((__threadfence();))
+#elif defined(AMREX_USE_SYCL)
+        AMREX_IF_ON_DEVICE((sycl::atomic_fence(sycl::memory_order::seq_cst, sycl::memory_scope::device);))
+#endif
+        AMREX_IF_ON_HOST((std::atomic_thread_fence(std::memory_order_seq_cst);))
+    }
+
+    struct HSEColumnCache
+    {
+        // the columns of one boundary strip, with the normal index set to 0
+        Box columns;
+        int dir = 0;
+
+        int* lock = nullptr;
+        int* nzones = nullptr;
+        Real* key = nullptr;
+        Real* profile = nullptr;
+        unsigned long long* counts = nullptr;
+
+        // index of the column through (i, j, k), or -1 if it is not cached
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        int column (int i, int j, int k) const
+        {
+            amrex::ignore_unused(i, j, k);
+
+            if (lock == nullptr) {
+                return -1;
+            }
+
+            IntVect iv(AMREX_D_DECL(i, j, k));
+            iv[dir] = 0;
+
+            return columns.contains(iv) ? static_cast<int>(columns.index(iv)) : -1;
+        }
+
+        // Take ownership of the column.  Boxes that overlap in the
+        // transverse directions can fill the same column concurrently;
+        // rather than wait, the one that loses just does not use the cache.
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        bool acquire (int col, int nz) const
+        {
+            if (col < 0 || nz > HSE_MAX_ZONES) {
+                return false;
+            }
+
+            if (Gpu::Atomic::CAS(lock + col, 0, 1) != 0) {
+                return false;
+            }
+
+            hse_cache_fence();
+            return true;
+        }
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        void release (int col) const
+        {
+            hse_cache_fence();
+            Gpu::Atomic::Exch(lock + col, 0);
+        }
+
+        // does the stored profile match this interior state and cover nz zones?
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        bool lookup (int col, const Real* k, int nz) const
+        {
+            if (nzones[col] < nz) {
+                return false;
+            }
+
+            constexpr Real tol = 10.0_rt * std::numeric_limits<Real>::epsilon();
+
+            for (int n = 0; n < HSE_NKEY; n++) {
+                if (std::abs(key[col * HSE_NKEY + n] - k[n]) > tol * std::abs(k[n])) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        void set_key (int col, const Real* k, int nz) const
+        {
+            for (int n = 0; n < HSE_NKEY; n++) {
+                key[col * HSE_NKEY + n] = k[n];
+            }
+            nzones[col] = nz;
+        }
+
+        // comp-th profile quantity in the zone that is n zones outside the domain
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        Real& prof (int col, int n, int comp) const
+        {
+            return profile[(col * HSE_MAX_ZONES + n) * HSE_NPROF + comp];
+        }
+
+        AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+        void count (bool hit) const
+        {
+            if (counts != nullptr) {
+                Gpu::Atomic::Add(counts + (hit ? 0 : 1), 1ULL);
+            }
+        }
+    };
+
+    struct HSEStripStorage
+    {
+        Box columns;
+        Long last_use = 0;
+        std::size_t bytes = 0;
+        Gpu::DeviceVector<int> lock;
+        Gpu::DeviceVector<int> nzones;
+        Gpu::DeviceVector<Real> key;
+        Gpu::DeviceVector<Real> profile;
+    };
+
+    // Keyed by the domain (i.e., the level), the face, and the strip of
+    // ghost zones next to the domain that a boundary fill covers, so a
+    // rank only stores the columns it actually fills.  The strips of a
+    // rank change when the grids change, so the least recently used
+    // strips are dropped to keep the total under hse_fill_cache_max_mb.
+
+    using HSEStripId = std::array<int, 4 * AMREX_SPACEDIM + 1>;
+
+    std::map<HSEStripId, HSEStripStorage> hse_cache_storage;
+
+    std::size_t hse_cache_bytes = 0;
+    Long hse_cache_clock = 0;
+
+    // number of column fills that were copied from the cache and that were computed
+
+    std::unique_ptr<Gpu::DeviceVector<unsigned long long>> hse_cache_counts;
+
+    HSEColumnCache
+    get_hse_cache (const Geometry& geom, int dir, int side, const Box& strip)
+    {
+        HSEColumnCache cache;
+        cache.dir = dir;
+
+        if (!castro::hse_fill_cache) {
+            return cache;
+        }
+
+        // We are called from inside the MFIter loops of FillPatch.
+
+#ifdef AMREX_USE_OMP
+#pragma omp critical (hse_fill_cache)
+#endif
+        {
+            if (hse_cache_counts == nullptr) {
+                hse_cache_counts = std::make_unique<Gpu::DeviceVector<unsigned long long>>(2, 0);
+                amrex::ExecOnFinalize([] () {
+                    hse_cache_storage.clear();
+                    hse_cache_bytes = 0;
+                    hse_cache_counts.reset();
+                });
+            }
+
+            const Box& domain = geom.Domain();
+
+            HSEStripId id;
+            for (int d = 0; d < AMREX_SPACEDIM; d++) {
+                id[d] = domain.smallEnd(d);
+                id[AMREX_SPACEDIM + d] = domain.bigEnd(d);
+                id[2 * AMREX_SPACEDIM + d] = strip.smallEnd(d);
+                id[3 * AMREX_SPACEDIM + d] = strip.bigEnd(d);
+            }
+            id[4 * AMREX_SPACEDIM] = 2 * dir + side;
+
+            Box columns = strip;
+            columns.setSmall(dir, 0);
+            columns.setBig(dir, 0);
+
+            const auto ncol = static_cast<std::size_t>(columns.numPts());
+            const std::size_t bytes = ncol * (2 * sizeof(int) + (HSE_NKEY + HSE_MAX_ZONES * HSE_NPROF) * sizeof(Real));
+            const auto max_bytes = static_cast<std::size_t>(castro::hse_fill_cache_max_mb * 1024.0 * 1024.0);
+
+            auto it = hse_cache_storage.find(id);
+
+            if (it == hse_cache_storage.end() && bytes <= max_bytes) {
+
+                if (hse_cache_bytes + bytes > max_bytes) {
+
+                    // kernels still in flight may be using the strips we drop
+
+                    Gpu::streamSynchronize();
+
+                    while (hse_cache_bytes + bytes > max_bytes) {
+                        auto oldest = hse_cache_storage.begin();
+                        for (auto jt = hse_cache_storage.begin(); jt != hse_cache_storage.end(); ++jt) {
+                            if (jt->second.last_use < oldest->second.last_use) {
+                                oldest = jt;
+                            }
+                        }
+                        hse_cache_bytes -= oldest->second.bytes;
+                        hse_cache_storage.erase(oldest);
+                    }
+                }
+
+                HSEStripStorage& storage = hse_cache_storage[id];
+
+                storage.columns = columns;
+                storage.bytes = bytes;
+                storage.lock.resize(ncol, 0);
+                storage.nzones.resize(ncol, 0);
+                storage.key.resize(ncol * HSE_NKEY);
+                storage.profile.resize(ncol * HSE_MAX_ZONES * HSE_NPROF);
+
+                hse_cache_bytes += bytes;
+
+                Gpu::streamSynchronize();
+
+                it = hse_cache_storage.find(id);
+            }
+
+            if (it != hse_cache_storage.end()) {
+                HSEStripStorage& storage = it->second;
+                storage.last_use = ++hse_cache_clock;
+
+                cache.columns = storage.columns;
+                cache.lock = storage.lock.data();
+                cache.nzones = storage.nzones.data();
+                cache.key = storage.key.data();
+                cache.profile = storage.profile.data();
+            }
+
+            cache.counts = hse_cache_counts->data();
+        }
+
+        return cache;
+    }
+
+}
+
+void
+hse_fill_cache_stats (Long& hits, Long& misses)
+{
+    hits = 0;
+    misses = 0;
+
+    if (hse_cache_counts != nullptr) {
+        Gpu::HostVector<unsigned long long> counts(2);
+        Gpu::copy(Gpu::deviceToHost, hse_cache_counts->begin(), hse_cache_counts->end(), counts.begin());
+
+        hits = static_cast<Long>(counts[0]);
+        misses = static_cast<Long>(counts[1]);
+    }
+}
 
 // a hydrostatic boundary conditions -- this relies on the assumption
 // that the gravitation acceleration is constant
@@ -47,6 +331,8 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(AMREX_D_DECL(domlo[0]-1, lo[1], lo[2])),
                     IntVect(AMREX_D_DECL(domlo[0]-1, hi[1], hi[2])));
 
+            const auto cache = get_hse_cache(geom, 0, 0, gbx);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
             {
@@ -88,84 +374,120 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
 
                 Real pres_above = eos_state.p;
 
-                for (int ii = domlo[0]-1; ii >= adv_lo[0]; ii--) {
+                // if we have seen this interior state before, copy the profile
+
+                const int nz = domlo[0] - adv_lo[0];
 
-                    // we are integrating along a column at constant i.
-                    // Make sure that our starting state is well-defined
+                Real key[HSE_NKEY];
+                key[0] = dens_above;
+                key[1] = temp_above;
+                key[2] = hse_interp_temp == 1 ? adv(domlo[0]+1,j,k,UTEMP) : 0.0_rt;
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
 
-                    // HSE integration to get density, pressure
+                const int col = cache.column(i, j, k);
+                const bool owner = cache.acquire(col, nz);
+                const bool cached = owner && cache.lookup(col, key, nz);
 
-                    // initial guesses
+                cache.count(cached);
 
-                    Real dens_zone = dens_above;
+                for (int ii = domlo[0]-1; ii >= adv_lo[0]; ii--) {
 
-                    // temperature and species held constant in BCs
+                    const int nzone = domlo[0] - 1 - ii;
 
+                    Real dens_zone;
                     Real temp_zone;
-                    if (hse_interp_temp == 1) {
-                        temp_zone = 2*adv(ii+1,j,k,UTEMP) - adv(ii+2,j,k,UTEMP);
+
+                    if (cached) {
+
+                        dens_zone = cache.prof(col, nzone, 0);
+                        temp_zone = cache.prof(col, nzone, 1);
+
                     } else {
-                        if (hse_fixed_temp > 0.0_rt) {
-                            temp_zone = hse_fixed_temp;
+
+                        // we are integrating along a column at constant i.
+                        // Make sure that our starting state is well-defined
+
+                        // HSE integration to get density, pressure
+
+                        // initial guesses
+
+                        dens_zone = dens_above;
+
+                        // temperature and species held constant in BCs
+
+                        if (hse_interp_temp == 1) {
+                            temp_zone = 2*adv(ii+1,j,k,UTEMP) - adv(ii+2,j,k,UTEMP);
                         } else {
-                            temp_zone = temp_above;
+                            if (hse_fixed_temp > 0.0_rt) {
+                                temp_zone = hse_fixed_temp;
+                            } else {
+                                temp_zone = temp_above;
+                            }
                         }
-                    }
 
-                    [[maybe_unused]] bool converged_hse = false;
+                        [[maybe_unused]] bool converged_hse = false;
 
-                    Real p_want;
-                    Real drho;
+                        Real p_want;
+                        Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        // pressure needed from HSE
+                            // pressure needed from HSE
 
-                        p_want = pres_above -
-                            dx[0] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
+                            p_want = pres_above -
+                                dx[0] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
 
-                        // pressure from EOS
+                            // pressure from EOS
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        eos(eos_input_rt, eos_state);
+                            eos(eos_input_rt, eos_state);
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                            Real pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr + 0.5_rt * dx[0] * gravity::const_grav);
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr + 0.5_rt * dx[0] * gravity::const_grav);
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
 
-                        // convergence?
+                            // convergence?
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
 
-                    }
+                        }
 
 #ifndef AMREX_USE_GPU
-                    if (! converged_hse) {
-                        std::cout << "ii, j, k, domlo[0]: " << ii << " " << j << " " << k << " " << domlo[0] << std::endl;
-                        std::cout << "p_want:    " << p_want << std::endl;
-                        std::cout << "dens_zone: " << dens_zone << std::endl;
-                        std::cout << "temp_zone: " << temp_zone << std::endl;
-                        std::cout << "drho:      " << drho << std::endl;
-                        std::cout << std::endl;
-                        std::cout << "column info: " << std::endl;
-                        std::cout << "   dens: " << adv(ii,j,k,URHO) << std::endl;
-                        std::cout << "   temp: " << adv(ii,j,k,UTEMP) << std::endl;
-                        amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -X BC");
-                   }
+                        if (! converged_hse) {
+                            std::cout << "ii, j, k, domlo[0]: " << ii << " " << j << " " << k << " " << domlo[0] << std::endl;
+                            std::cout << "p_want:    " << p_want << std::endl;
+                            std::cout << "dens_zone: " << dens_zone << std::endl;
+                            std::cout << "temp_zone: " << temp_zone << std::endl;
+                            std::cout << "drho:      " << drho << std::endl;
+                            std::cout << std::endl;
+                            std::cout << "column info: " << std::endl;
+                            std::cout << "   dens: " << adv(ii,j,k,URHO) << std::endl;
+                            std::cout << "   temp: " << adv(ii,j,k,UTEMP) << std::endl;
+                            amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -X BC");
+                       }
 #endif
 
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -195,13 +517,32 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                       }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
+
+                   if (cached) {
+
+                       pres_zone = cache.prof(col, nzone, 2);
+                       eint = cache.prof(col, nzone, 3);
+
+                   } else {
 
-                   eos(eos_input_rt, eos_state);
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                       eos(eos_input_rt, eos_state);
+
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (owner) {
+                           cache.prof(col, nzone, 0) = dens_zone;
+                           cache.prof(col, nzone, 1) = temp_zone;
+                           cache.prof(col, nzone, 2) = pres_zone;
+                           cache.prof(col, nzone, 3) = eint;
+                       }
+
+                   }
 
                    // store the final state
 
@@ -227,6 +568,13 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (owner) {
+                    if (!cached) {
+                        cache.set_key(col, key, nz);
+                    }
+                    cache.release(col);
+                }
             });
 
         }
@@ -243,6 +591,8 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(AMREX_D_DECL(domhi[0]+1, lo[1], lo[2])),
                     IntVect(AMREX_D_DECL(domhi[0]+1, hi[1], hi[2])));
 
+            const auto cache = get_hse_cache(geom, 0, 1, gbx);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
             {
@@ -284,79 +634,115 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
 
                 Real pres_below = eos_state.p;
 
-                for (int ii = domhi[0]+1; ii <= adv_hi[0]; ii++) {
+                // if we have seen this interior state before, copy the profile
+
+                const int nz = adv_hi[0] - domhi[0];
+
+                Real key[HSE_NKEY];
+                key[0] = dens_below;
+                key[1] = temp_below;
+                key[2] = hse_interp_temp == 1 ? adv(domhi[0]-1,j,k,UTEMP) : 0.0_rt;
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
+
+                const int col = cache.column(i, j, k);
+                const bool owner = cache.acquire(col, nz);
+                const bool cached = owner && cache.lookup(col, key, nz);
 
-                    // HSE integration to get density, pressure
+                cache.count(cached);
 
-                    // initial guesses
-                    Real dens_zone = dens_below;
+                for (int ii = domhi[0]+1; ii <= adv_hi[0]; ii++) {
 
-                    // temperature and species held constant in BCs
+                    const int nzone = ii - domhi[0] - 1;
 
+                    Real dens_zone;
                     Real temp_zone;
-                    if (hse_interp_temp == 1) {
-                        temp_zone = 2*adv(ii-1,j,k,UTEMP) - adv(ii-2,j,k,UTEMP);
+
+                    if (cached) {
+
+                        dens_zone = cache.prof(col, nzone, 0);
+                        temp_zone = cache.prof(col, nzone, 1);
+
                     } else {
-                        if (hse_fixed_temp > 0.0_rt) {
-                            temp_zone = hse_fixed_temp;
+
+                        // HSE integration to get density, pressure
+
+                        // initial guesses
+                        dens_zone = dens_below;
+
+                        // temperature and species held constant in BCs
+
+                        if (hse_interp_temp == 1) {
+                            temp_zone = 2*adv(ii-1,j,k,UTEMP) - adv(ii-2,j,k,UTEMP);
                         } else {
-                            temp_zone = temp_below;
+                            if (hse_fixed_temp > 0.0_rt) {
+                                temp_zone = hse_fixed_temp;
+                            } else {
+                                temp_zone = temp_below;
+                            }
                         }
-                    }
 
-                    [[maybe_unused]] bool converged_hse = false;
+                        [[maybe_unused]] bool converged_hse = false;
 
-                    Real p_want;
-                    Real drho;
+                        Real p_want;
+                        Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        // pressure needed from HSE
-                        p_want = pres_below +
-                            dx[0] * 0.5_rt * (dens_zone + dens_below) * gravity::const_grav;
+                            // pressure needed from HSE
+                            p_want = pres_below +
+                                dx[0] * 0.5_rt * (dens_zone + dens_below) * gravity::const_grav;
 
-                        // pressure from EOS
+                            // pressure from EOS
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        eos(eos_input_rt, eos_state);
+                            eos(eos_input_rt, eos_state);
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                            Real pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr - 0.5_rt * dx[0] * gravity::const_grav);
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr - 0.5_rt * dx[0] * gravity::const_grav);
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
 
-                        // convergence?
+                            // convergence?
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
 
-                    }
+                        }
 
 #ifndef AMREX_USE_GPU
-                   if (! converged_hse) {
-                       std::cout << "ii, j, k, domhi[0]: " << ii << " " << j << " " << k << " " << domhi[0] << std::endl;
-                       std::cout << "p_want:    " << p_want << std::endl;
-                       std::cout << "dens_zone: " << dens_zone << std::endl;
-                       std::cout << "temp_zone: " << temp_zone << std::endl;
-                       std::cout << "drho:      " << drho << std::endl;
-                       std::cout << std::endl;
-                       std::cout << "column info: " << std::endl;
-                       std::cout << "   dens: " << adv(ii,j,k,URHO) << std::endl;
-                       std::cout << "   temp: " << adv(ii,j,k,UTEMP) << std::endl;
-                       amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in +X BC");
-                   }
+                       if (! converged_hse) {
+                           std::cout << "ii, j, k, domhi[0]: " << ii << " " << j << " " << k << " " << domhi[0] << std::endl;
+                           std::cout << "p_want:    " << p_want << std::endl;
+                           std::cout << "dens_zone: " << dens_zone << std::endl;
+                           std::cout << "temp_zone: " << temp_zone << std::endl;
+                           std::cout << "drho:      " << drho << std::endl;
+                           std::cout << std::endl;
+                           std::cout << "column info: " << std::endl;
+                           std::cout << "   dens: " << adv(ii,j,k,URHO) << std::endl;
+                           std::cout << "   temp: " << adv(ii,j,k,UTEMP) << std::endl;
+                           amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in +X BC");
+                       }
 #endif
 
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -386,13 +772,32 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
+
+                   if (cached) {
 
-                   eos(eos_input_rt, eos_state);
+                       pres_zone = cache.prof(col, nzone, 2);
+                       eint = cache.prof(col, nzone, 3);
+
+                   } else {
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
+
+                       eos(eos_input_rt, eos_state);
+
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (owner) {
+                           cache.prof(col, nzone, 0) = dens_zone;
+                           cache.prof(col, nzone, 1) = temp_zone;
+                           cache.prof(col, nzone, 2) = pres_zone;
+                           cache.prof(col, nzone, 3) = eint;
+                       }
+
+                   }
 
                    //  store the final state
 
@@ -418,6 +823,13 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_below = pres_zone;
 
                 }
+
+                if (owner) {
+                    if (!cached) {
+                        cache.set_key(col, key, nz);
+                    }
+                    cache.release(col);
+                }
             });
 
        }
@@ -439,6 +851,8 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(AMREX_D_DECL(lo[0], domlo[1]-1, lo[2])),
                     IntVect(AMREX_D_DECL(hi[0], domlo[1]-1, hi[2])));
 
+            const auto cache = get_hse_cache(geom, 1, 0, gbx);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
             {
@@ -480,81 +894,117 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
 
                 Real pres_above = eos_state.p;
 
-                for (int jj = domlo[1]-1; jj >= adv_lo[1]; jj--) {
+                // if we have seen this interior state before, copy the profile
 
-                    // HSE integration to get density, pressure
+                const int nz = domlo[1] - adv_lo[1];
 
-                    // initial guesses
+                Real key[HSE_NKEY];
+                key[0] = dens_above;
+                key[1] = temp_above;
+                key[2] = hse_interp_temp == 1 ? adv(i,domlo[1]+1,k,UTEMP) : 0.0_rt;
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
 
-                    Real dens_zone = dens_above;
+                const int col = cache.column(i, j, k);
+                const bool owner = cache.acquire(col, nz);
+                const bool cached = owner && cache.lookup(col, key, nz);
 
-                    // temperature and species held constant in BCs
+                cache.count(cached);
 
+                for (int jj = domlo[1]-1; jj >= adv_lo[1]; jj--) {
+
+                    const int nzone = domlo[1] - 1 - jj;
+
+                    Real dens_zone;
                     Real temp_zone;
-                    if (hse_interp_temp == 1) {
-                        temp_zone = 2*adv(i,jj+1,k,UTEMP) - adv(i,jj+2,k,UTEMP);
+
+                    if (cached) {
+
+                        dens_zone = cache.prof(col, nzone, 0);
+                        temp_zone = cache.prof(col, nzone, 1);
+
                     } else {
-                        if (hse_fixed_temp > 0.0_rt) {
-                            temp_zone = hse_fixed_temp;
+
+                        // HSE integration to get density, pressure
+
+                        // initial guesses
+
+                        dens_zone = dens_above;
+
+                        // temperature and species held constant in BCs
+
+                        if (hse_interp_temp == 1) {
+                            temp_zone = 2*adv(i,jj+1,k,UTEMP) - adv(i,jj+2,k,UTEMP);
                         } else {
-                            temp_zone = temp_above;
+                            if (hse_fixed_temp > 0.0_rt) {
+                                temp_zone = hse_fixed_temp;
+                            } else {
+                                temp_zone = temp_above;
+                            }
                         }
-                    }
 
-                    [[maybe_unused]] bool converged_hse = false;
+                        [[maybe_unused]] bool converged_hse = false;
 
-                    Real p_want;
-                    Real drho;
+                        Real p_want;
+                        Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        // pressure needed from HSE
+                            // pressure needed from HSE
 
-                        p_want = pres_above -
-                            dx[1] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
+                            p_want = pres_above -
+                                dx[1] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
 
-                        // pressure from EOS
+                            // pressure from EOS
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        eos(eos_input_rt, eos_state);
+                            eos(eos_input_rt, eos_state);
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                            Real pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr + 0.5_rt * dx[1] * gravity::const_grav);
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr + 0.5_rt * dx[1] * gravity::const_grav);
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
 
-                        // convergence?
+                            // convergence?
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
 
-                    }
+                        }
 
 #ifndef AMREX_USE_GPU
-                   if (! converged_hse) {
-                       std::cout << "i, jj, k, domlo[1]: " << i << " " << jj << " " << k << " " << domlo[1] << std::endl;
-                       std::cout << "p_want:    " << p_want << std::endl;
-                       std::cout << "dens_zone: " << dens_zone << std::endl;
-                       std::cout << "temp_zone: " << temp_zone << std::endl;
-                       std::cout << "drho:      " << drho << std::endl;
-                       std::cout << std::endl;
-                       std::cout << "column info: " << std::endl;
-                       std::cout << "   dens: " << adv(i,jj,k,URHO) << std::endl;
-                       std::cout << "   temp: " << adv(i,jj,k,UTEMP) << std::endl;
-                       amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -Y BC");
-                   }
+                       if (! converged_hse) {
+                           std::cout << "i, jj, k, domlo[1]: " << i << " " << jj << " " << k << " " << domlo[1] << std::endl;
+                           std::cout << "p_want:    " << p_want << std::endl;
+                           std::cout << "dens_zone: " << dens_zone << std::endl;
+                           std::cout << "temp_zone: " << temp_zone << std::endl;
+                           std::cout << "drho:      " << drho << std::endl;
+                           std::cout << std::endl;
+                           std::cout << "column info: " << std::endl;
+                           std::cout << "   dens: " << adv(i,jj,k,URHO) << std::endl;
+                           std::cout << "   temp: " << adv(i,jj,k,UTEMP) << std::endl;
+                           amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -Y BC");
+                       }
 #endif
 
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -584,13 +1034,32 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
+
+                   if (cached) {
+
+                       pres_zone = cache.prof(col, nzone, 2);
+                       eint = cache.prof(col, nzone, 3);
+
+                   } else {
+
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
+
+                       eos(eos_input_rt, eos_state);
 
-                   eos(eos_input_rt, eos_state);
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                       if (owner) {
+                           cache.prof(col, nzone, 0) = dens_zone;
+                           cache.prof(col, nzone, 1) = temp_zone;
+                           cache.prof(col, nzone, 2) = pres_zone;
+                           cache.prof(col, nzone, 3) = eint;
+                       }
+
+                   }
 
                    // store the final state
 
@@ -616,6 +1085,13 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (owner) {
+                    if (!cached) {
+                        cache.set_key(col, key, nz);
+                    }
+                    cache.release(col);
+                }
             });
 
        }
@@ -633,6 +1109,8 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(AMREX_D_DECL(lo[0], domhi[1]+1, lo[2])),
                     IntVect(AMREX_D_DECL(hi[0], domhi[1]+1, hi[2])));
 
+            const auto cache = get_hse_cache(geom, 1, 1, gbx);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
             {
@@ -674,79 +1152,115 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
 
                 Real pres_below = eos_state.p;
 
-                for (int jj = domhi[1]+1; jj <= adv_hi[1]; jj++) {
+                // if we have seen this interior state before, copy the profile
 
-                    // HSE integration to get density, pressure
+                const int nz = adv_hi[1] - domhi[1];
 
-                    // initial guesses
-                    Real dens_zone = dens_below;
+                Real key[HSE_NKEY];
+                key[0] = dens_below;
+                key[1] = temp_below;
+                key[2] = hse_interp_temp == 1 ? adv(i,domhi[1]-1,k,UTEMP) : 0.0_rt;
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
+
+                const int col = cache.column(i, j, k);
+                const bool owner = cache.acquire(col, nz);
+                const bool cached = owner && cache.lookup(col, key, nz);
 
-                    // temperature and species held constant in BCs
+                cache.count(cached);
+
+                for (int jj = domhi[1]+1; jj <= adv_hi[1]; jj++) {
 
+                    const int nzone = jj - domhi[1] - 1;
+
+                    Real dens_zone;
                     Real temp_zone;
-                    if (hse_interp_temp == 1) {
-                        temp_zone = 2*adv(i,jj-1,k,UTEMP) - adv(i,jj-2,k,UTEMP);
+
+                    if (cached) {
+
+                        dens_zone = cache.prof(col, nzone, 0);
+                        temp_zone = cache.prof(col, nzone, 1);
+
                     } else {
-                        if (hse_fixed_temp > 0.0_rt) {
-                            temp_zone = hse_fixed_temp;
+
+                        // HSE integration to get density, pressure
+
+                        // initial guesses
+                        dens_zone = dens_below;
+
+                        // temperature and species held constant in BCs
+
+                        if (hse_interp_temp == 1) {
+                            temp_zone = 2*adv(i,jj-1,k,UTEMP) - adv(i,jj-2,k,UTEMP);
                         } else {
-                            temp_zone = temp_below;
+                            if (hse_fixed_temp > 0.0_rt) {
+                                temp_zone = hse_fixed_temp;
+                            } else {
+                                temp_zone = temp_below;
+                            }
                         }
-                    }
 
-                    [[maybe_unused]] bool converged_hse = false;
+                        [[maybe_unused]] bool converged_hse = false;
 
-                    Real p_want;
-                    Real drho;
+                        Real p_want;
+                        Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        // pressure needed from HSE
-                        p_want = pres_below +
-                            dx[1] * 0.5_rt * (dens_zone + dens_below) * gravity::const_grav;
+                            // pressure needed from HSE
+                            p_want = pres_below +
+                                dx[1] * 0.5_rt * (dens_zone + dens_below) * gravity::const_grav;
 
-                        // pressure from EOS
+                            // pressure from EOS
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        eos(eos_input_rt, eos_state);
+                            eos(eos_input_rt, eos_state);
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                            Real pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr - 0.5_rt * dx[1] * gravity::const_grav);
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr - 0.5_rt * dx[1] * gravity::const_grav);
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
 
-                        // convergence?
+                            // convergence?
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
 
-                    }
+                        }
 
 #ifndef AMREX_USE_GPU
-                   if (! converged_hse) {
-                       std::cout << "i, jj, k, domhi[1]: " << i << " " << jj << " " << k << " " << domhi[1] << std::endl;
-                       std::cout << "p_want:    " << p_want << std::endl;
-                       std::cout << "dens_zone: " << dens_zone << std::endl;
-                       std::cout << "temp_zone: " << temp_zone << std::endl;
-                       std::cout << "drho:      " << drho << std::endl;
-                       std::cout << std::endl;
-                       std::cout << "column info: " << std::endl;
-                       std::cout << "   dens: " << adv(i,jj,k,URHO) << std::endl;
-                       std::cout << "   temp: " << adv(i,jj,k,UTEMP) << std::endl;
-                       amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in +Y BC");
-                   }
+                       if (! converged_hse) {
+                           std::cout << "i, jj, k, domhi[1]: " << i << " " << jj << " " << k << " " << domhi[1] << std::endl;
+                           std::cout << "p_want:    " << p_want << std::endl;
+                           std::cout << "dens_zone: " << dens_zone << std::endl;
+                           std::cout << "temp_zone: " << temp_zone << std::endl;
+                           std::cout << "drho:      " << drho << std::endl;
+                           std::cout << std::endl;
+                           std::cout << "column info: " << std::endl;
+                           std::cout << "   dens: " << adv(i,jj,k,URHO) << std::endl;
+                           std::cout << "   temp: " << adv(i,jj,k,UTEMP) << std::endl;
+                           amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in +Y BC");
+                       }
 #endif
 
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -776,13 +1290,32 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
+
+                   if (cached) {
 
-                   eos(eos_input_rt, eos_state);
+                       pres_zone = cache.prof(col, nzone, 2);
+                       eint = cache.prof(col, nzone, 3);
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                   } else {
+
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
+
+                       eos(eos_input_rt, eos_state);
+
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (owner) {
+                           cache.prof(col, nzone, 0) = dens_zone;
+                           cache.prof(col, nzone, 1) = temp_zone;
+                           cache.prof(col, nzone, 2) = pres_zone;
+                           cache.prof(col, nzone, 3) = eint;
+                       }
+
+                   }
 
                    // store the final state
 
@@ -808,6 +1341,13 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_below = pres_zone;
 
                 }
+
+                if (owner) {
+                    if (!cached) {
+                        cache.set_key(col, key, nz);
+                    }
+                    cache.release(col);
+                }
             });
         }
 
@@ -828,6 +1368,8 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
             Box gbx(IntVect(AMREX_D_DECL(lo[0], lo[1], domlo[2]-1)),
                     IntVect(AMREX_D_DECL(hi[0], hi[1], domlo[2]-1)));
 
+            const auto cache = get_hse_cache(geom, 2, 0, gbx);
+
             amrex::ParallelFor(gbx,
             [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
             {
@@ -869,81 +1411,117 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
 
                 Real pres_above = eos_state.p;
 
-                for (int kk = domlo[2]-1; kk >= adv_lo[2]; kk--) {
+                // if we have seen this interior state before, copy the profile
 
-                    // HSE integration to get density, pressure
+                const int nz = domlo[2] - adv_lo[2];
 
-                    // initial guesses
+                Real key[HSE_NKEY];
+                key[0] = dens_above;
+                key[1] = temp_above;
+                key[2] = hse_interp_temp == 1 ? adv(i,j,domlo[2]+1,UTEMP) : 0.0_rt;
+                for (int n = 0; n < NumSpec; n++) {
+                    key[3+n] = X_zone[n];
+                }
+#if NAUX_NET > 0
+                for (int n = 0; n < NumAux; n++) {
+                    key[3+NumSpec+n] = aux_zone[n];
+                }
+#endif
+
+                const int col = cache.column(i, j, k);
+                const bool owner = cache.acquire(col, nz);
+                const bool cached = owner && cache.lookup(col, key, nz);
 
-                    Real dens_zone = dens_above;
+                cache.count(cached);
+
+                for (int kk = domlo[2]-1; kk >= adv_lo[2]; kk--) {
 
-                    // temperature and species held constant in BCs
+                    const int nzone = domlo[2] - 1 - kk;
 
+                    Real dens_zone;
                     Real temp_zone;
-                    if (hse_interp_temp == 1) {
-                        temp_zone = 2*adv(i,j,kk+1,UTEMP) - adv(i,j,kk+2,UTEMP);
+
+                    if (cached) {
+
+                        dens_zone = cache.prof(col, nzone, 0);
+                        temp_zone = cache.prof(col, nzone, 1);
+
                     } else {
-                        if (hse_fixed_temp > 0.0_rt) {
-                            temp_zone = hse_fixed_temp;
+
+                        // HSE integration to get density, pressure
+
+                        // initial guesses
+
+                        dens_zone = dens_above;
+
+                        // temperature and species held constant in BCs
+
+                        if (hse_interp_temp == 1) {
+                            temp_zone = 2*adv(i,j,kk+1,UTEMP) - adv(i,j,kk+2,UTEMP);
                         } else {
-                            temp_zone = temp_above;
+                            if (hse_fixed_temp > 0.0_rt) {
+                                temp_zone = hse_fixed_temp;
+                            } else {
+                                temp_zone = temp_above;
+                            }
                         }
-                    }
 
-                    [[maybe_unused]] bool converged_hse = false;
+                        [[maybe_unused]] bool converged_hse = false;
 
-                    Real p_want;
-                    Real drho;
+                        Real p_want;
+                        Real drho;
 
-                    for (int iter = 0; iter < hse::MAX_ITER; iter++) {
+                        for (int iter = 0; iter < hse::MAX_ITER; iter++) {
 
-                        // pressure needed from HSE
+                            // pressure needed from HSE
 
-                        p_want = pres_above -
-                            dx[2] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
+                            p_want = pres_above -
+                                dx[2] * 0.5_rt * (dens_zone + dens_above) * gravity::const_grav;
 
-                        // pressure from EOS
+                            // pressure from EOS
 
-                        eos_state.rho = dens_zone;
-                        eos_state.T = temp_zone;
-                        // xn is already set above
+                            eos_state.rho = dens_zone;
+                            eos_state.T = temp_zone;
+                            // xn is already set above
 
-                        eos(eos_input_rt, eos_state);
+                            eos(eos_input_rt, eos_state);
 
-                        Real pres_zone = eos_state.p;
-                        Real dpdr = eos_state.dpdr;
+                            Real pres_zone = eos_state.p;
+                            Real dpdr = eos_state.dpdr;
 
-                        // Newton-Raphson - we want to zero A = p_want - p(rho)
-                        Real A = p_want - pres_zone;
-                        drho = A / (dpdr + 0.5_rt * dx[2] * gravity::const_grav);
+                            // Newton-Raphson - we want to zero A = p_want - p(rho)
+                            Real A = p_want - pres_zone;
+                            drho = A / (dpdr + 0.5_rt * dx[2] * gravity::const_grav);
 
-                        dens_zone = amrex::max(0.9_rt*dens_zone,
-                                               amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
+                            dens_zone = amrex::max(0.9_rt*dens_zone,
+                                                   amrex::min(dens_zone + drho, 1.1_rt*dens_zone));
 
-                        // convergence?
+                            // convergence?
 
-                        if (std::abs(drho) < hse::TOL * dens_zone) {
-                            converged_hse = true;
-                            break;
-                        }
+                            if (std::abs(drho) < hse::TOL * dens_zone) {
+                                converged_hse = true;
+                                break;
+                            }
 
-                    }
+                        }
 
 #ifndef AMREX_USE_GPU
-                   if (! converged_hse) {
-                       std::cout << "i, j, kk, domlo[2]: " << i << " " << j << " " << kk << " " << domlo[2] << std::endl;
-                       std::cout << "p_want:    " << p_want << std::endl;
-                       std::cout << "dens_zone: " << dens_zone << std::endl;
-                       std::cout << "temp_zone: " << temp_zone << std::endl;
-                       std::cout << "drho:      " << drho << std::endl;
-                       std::cout << std::endl;
-                       std::cout << "column info: " << std::endl;
-                       std::cout << "   dens: " << adv(i,j,kk,URHO) << std::endl;
-                       std::cout << "   temp: " << adv(i,j,kk,UTEMP) << std::endl;
-                       amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -Z BC");
-                   }
+                       if (! converged_hse) {
+                           std::cout << "i, j, kk, domlo[2]: " << i << " " << j << " " << kk << " " << domlo[2] << std::endl;
+                           std::cout << "p_want:    " << p_want << std::endl;
+                           std::cout << "dens_zone: " << dens_zone << std::endl;
+                           std::cout << "temp_zone: " << temp_zone << std::endl;
+                           std::cout << "drho:      " << drho << std::endl;
+                           std::cout << std::endl;
+                           std::cout << "column info: " << std::endl;
+                           std::cout << "   dens: " << adv(i,j,kk,URHO) << std::endl;
+                           std::cout << "   temp: " << adv(i,j,kk,UTEMP) << std::endl;
+                           amrex::Error("ERROR in bc_ext_fill_nd: failure to converge in -Z BC");
+                       }
 #endif
 
+                    }
+
                    // velocity
 
                    if (hse_zero_vels == 1) {
@@ -973,13 +1551,32 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                        }
                    }
 
-                   eos_state.rho = dens_zone;
-                   eos_state.T = temp_zone;
+                   Real pres_zone;
+                   Real eint;
+
+                   if (cached) {
+
+                       pres_zone = cache.prof(col, nzone, 2);
+                       eint = cache.prof(col, nzone, 3);
+
+                   } else {
+
+                       eos_state.rho = dens_zone;
+                       eos_state.T = temp_zone;
+
+                       eos(eos_input_rt, eos_state);
 
-                   eos(eos_input_rt, eos_state);
+                       pres_zone = eos_state.p;
+                       eint = eos_state.e;
+
+                       if (owner) {
+                           cache.prof(col, nzone, 0) = dens_zone;
+                           cache.prof(col, nzone, 1) = temp_zone;
+                           cache.prof(col, nzone, 2) = pres_zone;
+                           cache.prof(col, nzone, 3) = eint;
+                       }
 
-                   Real pres_zone = eos_state.p;
-                   Real eint = eos_state.e;
+                   }
 
                    // store the final state
 
@@ -1005,6 +1602,13 @@ hse_fill(const Box& bx, Array4<Real> const& adv,
                    pres_above = pres_zone;
 
                 }
+
+                if (owner) {
+                    if (!cached) {
+                        cache.set_key(col, key, nz);
+                    }
+                    cache.release(col);
+                }
             });
         }
 
@@ -264,6 +264,22 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
 
   const Geometry& geom = parent->Geom(level);
 
+  // If opacity_lag_tol > 0, we keep the opacities, their temperature
+  // derivative, and c_v from the last evaluation in opac_cache, along
+  // with the temperature they were evaluated at in opac_temp, and only
+  // recompute them in zones where the temperature has since changed
+  // by more than opacity_lag_tol.  The cache is invalidated at the
+  // start of each implicit update (see MGFLD_implicit_update), since
+  // the density and composition change between updates.
+
+  const bool use_opac_cache = opacity_lag_tol > 0.0_rt && opac_temp[level] != nullptr;
+  const Real lag_tol = opacity_lag_tol;
+
+  const int icache_kp = 0;
+  const int icache_kr = nGroups;
+  const int icache_dkdT = 2 * nGroups;
+  const int icache_cv = 3 * nGroups;
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -274,9 +290,20 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
       auto temp_arr = temp_new[mfi].array();
       auto S_new_arr = S_new[mfi].array();
 
+      auto cache_arr = use_opac_cache ? (*opac_cache[level])[mfi].array() : Array4<Real>{};
+      auto cache_T_arr = use_opac_cache ? (*opac_temp[level])[mfi].array() : Array4<Real>{};
+
       amrex::ParallelFor(box,
       [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
       {
+          if (use_opac_cache) {
+              Real T_last = cache_T_arr(i,j,k,1);
+              if (T_last > 0.0_rt && std::abs(temp_arr(i,j,k) - T_last) <= lag_tol * T_last) {
+                  dedT_arr(i,j,k) = cache_arr(i,j,k,icache_cv);
+                  return;
+              }
+          }
+
           Real rhoInv = 1.e0_rt / S_new_arr(i,j,k,URHO);
 
           eos_re_t eos_state;
@@ -294,6 +321,11 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
           eos(eos_input_rt, eos_state);
 
           dedT_arr(i,j,k) = eos_state.cv;
+
+          if (use_opac_cache) {
+              cache_arr(i,j,k,icache_cv) = eos_state.cv;
+              cache_T_arr(i,j,k,1) = temp_arr(i,j,k);
+          }
       });
   }
 
@@ -301,6 +333,10 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
     dedT.mult(dedT_fac);
   }
 
+  ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
+  ReduceData<Long, Long> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -316,6 +352,9 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
       auto jg_arr = jg[mfi].array();
       auto djdT_arr = djdT[mfi].array();
 
+      auto cache_arr = use_opac_cache ? (*opac_cache[level])[mfi].array() : Array4<Real>{};
+      auto cache_T_arr = use_opac_cache ? (*opac_temp[level])[mfi].array() : Array4<Real>{};
+
       bool use_dkdT_loc = use_dkdT;
 
       GpuArray<Real, NGROUPS> nugroup_loc;
@@ -327,20 +366,32 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
           xnu_loc[g] = xnu[g];
       }
 
-      amrex::ParallelFor(bx,
-      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+      reduce_op.eval(bx, reduce_data,
+      [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
       {
           const Real fac = 0.5e0_rt;
           const Real minfrac = 1.e-8_rt;
 
           if (lag_opac) {
               dkdT_arr(i,j,k) = 0.0_rt;
-              return;
+              return {0, 0};
           }
 
           Real rho = S_new_arr(i,j,k,URHO);
           Real temp = temp_new_arr(i,j,k);
 
+          if (use_opac_cache) {
+              Real T_last = cache_T_arr(i,j,k,0);
+              if (T_last > 0.0_rt && std::abs(temp - T_last) <= lag_tol * T_last) {
+                  for (int g = 0; g < NGROUPS; ++g) {
+                      kappa_p_arr(i,j,k,g) = cache_arr(i,j,k,icache_kp+g);
+                      kappa_r_arr(i,j,k,g) = cache_arr(i,j,k,icache_kr+g);
+                      dkdT_arr(i,j,k,g) = cache_arr(i,j,k,icache_dkdT+g);
+                  }
+                  return {0, 1};
+              }
+          }
+
           Real Ye;
           if (NumAux > 0) {
               Real Ye = S_new_arr(i,j,k,UFX);
@@ -386,6 +437,17 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
                   dkdT_arr(i,j,k,g) = (kp2 - kp1) / (2.e0_rt * dT);
               }
           }
+
+          if (use_opac_cache) {
+              for (int g = 0; g < NGROUPS; ++g) {
+                  cache_arr(i,j,k,icache_kp+g) = kappa_p_arr(i,j,k,g);
+                  cache_arr(i,j,k,icache_kr+g) = kappa_r_arr(i,j,k,g);
+                  cache_arr(i,j,k,icache_dkdT+g) = dkdT_arr(i,j,k,g);
+              }
+              cache_T_arr(i,j,k,0) = temp;
+          }
+
+          return {1, 0};
       });
 
       const Box& reg = mfi.tilebox();
@@ -431,6 +493,10 @@ void Radiation::eos_opacity_emissivity(const MultiFab& S_new,
       });
   }
 
+  ReduceTuple hv = reduce_data.value();
+  opac_zones_computed += amrex::get<0>(hv) * nGroups;
+  opac_zones_reused += amrex::get<1>(hv) * nGroups;
+
   if (ngrow == 0 && !lag_opac) {
       kappa_r.FillBoundary(geom.periodicity());
   }
@@ -189,6 +189,14 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
   Real reltol_in = relInTol;
   Real ptc_tau = 0.0;  // not being used
 
+  // the cached opacities are only valid for the density and
+  // composition of this update
+  if (opac_temp[level]) {
+      opac_temp[level]->setVal(-1.0);
+  }
+  opac_zones_computed = 0;
+  opac_zones_reused = 0;
+
   // nonlinear loop for all groups
   int it = 0;
   bool conservative_update = false;
@@ -492,6 +500,15 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
     std::cout.precision(oldprec);
   }
 
+  if (verbose >= 1 && opac_temp[level]) {
+      Long n_computed = opac_zones_computed;
+      Long n_reused = opac_zones_reused;
+      ParallelDescriptor::ReduceLongSum(n_computed);
+      ParallelDescriptor::ReduceLongSum(n_reused);
+      amrex::Print() << "Opacities: recomputed " << n_computed << ", reused " << n_reused
+                     << " zone-groups" << std::endl;
+  }
+
   if (!converged) {
       amrex::Abort("Implicit Update Failed to Converge");
   }
@@ -3,6 +3,7 @@
 #endif
 
 #include <Radiation.H>
+#include <blackbody.H>
 
 #include <AMReX_ParmParse.H>
 
@@ -80,6 +81,28 @@ void Radiation::get_groups(int verbose)
     for (int i = 0; i < nGroups; ++i) {
         lognugroup[i] = std::log(nugroup[i]);
     }
+
+    // Tabulate the incomplete Planck integral so that the group
+    // emission in eos_opacity_emissivity does not have to sum the
+    // polylogarithm series in every zone.  Fall back to the series
+    // if the table is not accurate enough.
+
+    int use_planck_table = 1;
+    pp.query("use_planck_table", use_planck_table);
+
+    Real planck_table_tol = 1.e-8;
+    pp.query("planck_table_tol", planck_table_tol);
+
+    if (use_planck_table) {
+      Real table_error = blackbody::init_table(verbose);
+      if (table_error > planck_table_tol) {
+        blackbody::table_initialized = false;
+        if (verbose >= 1 && ParallelDescriptor::IOProcessor()) {
+          std::cout << "Planck integral table error " << table_error
+                    << " exceeds radiation.planck_table_tol, using the series instead" << std::endl;
+        }
+      }
+    }
   }
 
   if (ParallelDescriptor::IOProcessor()) {
@@ -348,6 +348,9 @@ Radiation::Radiation(Amr* Parent, Castro* castro, int restart)
   pp.query("update_opacity", update_opacity);
   pp.query("update_limiter", update_limiter);
 
+  opacity_lag_tol = 0.0;
+  pp.query("opacity_lag_tol", opacity_lag_tol);
+
   dT  = 1.0;                 pp.query("delta_temp", dT);
 
   // for inner iterations of neutrino J equation
@@ -491,6 +494,9 @@ Radiation::Radiation(Amr* Parent, Castro* castro, int restart)
 
   plotvar.resize(levels);
 
+  opac_cache.resize(levels);
+  opac_temp.resize(levels);
+
   delta_t_old.resize(levels, 0.0);
 
   delta_e_rat_level.resize(levels, 0.0);
@@ -528,6 +534,12 @@ void Radiation::regrid(int level, const BoxArray& grids, const DistributionMappi
       plotvar[level]->setVal(0.0);
   }
 
+  if (SolverType == MGFLDSolver && opacity_lag_tol > 0.0) {
+      opac_cache[level].reset(new MultiFab(grids, dmap, 3*nGroups+1, 1));
+      opac_temp[level].reset(new MultiFab(grids, dmap, 2, 1));
+      opac_temp[level]->setVal(-1.0);
+  }
+
   // This array will not be used on the finest level.  I create it here,
   // though, in case a finer level is created before this level is next
   // regridded:
@@ -555,6 +567,9 @@ void Radiation::close(int level)
 
     plotvar[level].reset();
 
+    opac_cache[level].reset();
+    opac_temp[level].reset();
+
     if (verbose > 1 && ParallelDescriptor::IOProcessor()) {
       std::cout << "                                       done" << std::endl;
     }
@@ -0,0 +1,90 @@
+#include <AMReX_Print.H>
+
+#include <blackbody.H>
+
+#include <cmath>
+
+using namespace amrex;
+
+namespace blackbody {
+    AMREX_GPU_MANAGED bool table_initialized = false;
+    AMREX_GPU_MANAGED Real table_ulo;
+    AMREX_GPU_MANAGED Real table_du;
+    AMREX_GPU_MANAGED amrex::Array1D<Real, 0, table_size-1> table_g;
+    AMREX_GPU_MANAGED amrex::Array1D<Real, 0, table_size-1> table_dgdu;
+}
+
+Real
+blackbody::init_table (int verbose)
+{
+    table_initialized = false;
+
+    table_ulo = std::log(xsmall);
+    table_du = (std::log(xlarge) - table_ulo) / static_cast<Real>(table_size - 1);
+
+    // Fill the table from the series.  The derivative is known exactly:
+    // d integ / dx = x^3 / (exp(x) - 1), so dg/du = x^4 / ((exp(x) - 1) integ).
+
+    for (int i = 0; i < table_size; ++i) {
+        Real x = std::exp(table_ulo + static_cast<Real>(i) * table_du);
+        Real integ = integ_series(x);
+
+        table_g(i) = std::log(integ);
+        table_dgdu(i) = std::pow(x, 4) / (std::expm1(x) * integ);
+    }
+
+    // g is monotonically increasing; make sure the interpolant is
+    // too (Fritsch & Carlson 1980).  With the exact derivatives this
+    // should rarely, if ever, change anything.
+
+    for (int i = 0; i < table_size - 1; ++i) {
+        Real delta = (table_g(i+1) - table_g(i)) / table_du;
+
+        if (delta <= 0.0_rt) {
+            table_dgdu(i) = 0.0_rt;
+            table_dgdu(i+1) = 0.0_rt;
+            continue;
+        }
+
+        Real alpha = table_dgdu(i) / delta;
+        Real beta = table_dgdu(i+1) / delta;
+
+        if (alpha * alpha + beta * beta > 9.0_rt) {
+            Real tau = 3.0_rt / std::sqrt(alpha * alpha + beta * beta);
+            table_dgdu(i) = tau * alpha * delta;
+            table_dgdu(i+1) = tau * beta * delta;
+        }
+    }
+
+    // Check the interpolant against the series between the table
+    // points, where the interpolation error is largest.
+
+    const int nsub = 4;
+
+    Real max_error = 0.0_rt;
+    Real x_max_error = xsmall;
+
+    for (int i = 0; i < table_size - 1; ++i) {
+        for (int n = 1; n < nsub; ++n) {
+            Real u = table_ulo + (static_cast<Real>(i) + static_cast<Real>(n) / nsub) * table_du;
+            Real x = std::exp(u);
+
+            Real exact = integ_series(x);
+            Real error = std::abs(integ_table(x) - exact) / exact;
+
+            if (error > max_error) {
+                max_error = error;
+                x_max_error = x;
+            }
+        }
+    }
+
+    table_initialized = true;
+
+    if (verbose >= 1) {
+        amrex::Print() << "Planck integral table: " << table_size << " points, max relative error = "
+                       << max_error << " at h nu / kT = " << x_max_error << std::endl;
+    }
+
+    return max_error;
+}
@@ -5,6 +5,7 @@
 #include <model_parser.H>
 #endif
 #include <sdc_cons_to_burn.H>
+#include <box_summary.H>
 
 using std::string;
 using namespace amrex;
@@ -186,14 +187,25 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
     MultiFab tmp_mask_mf;
     const MultiFab& mask_mf = mask_covered_zones ? getLevel(level+1).build_fine_mask() : tmp_mask_mf;
 
+    // If a (rho, T) limit is set, we can check a whole box at once
+    // and skip it if none of its zones would burn.  The limits have
+    // the same defaults as in valid_zones_to_burn.
+
+    const bool skip_boxes = react_box_skip &&
+                            (react_rho_min >= 1.e-10 || react_rho_max <= 1.e199 ||
+                             react_T_min >= 1.e-10 || react_T_max <= 1.e199);
+
 #if defined(AMREX_USE_GPU)
     Gpu::Buffer<int> d_num_failed({0});
     auto* p_num_failed = d_num_failed.data();
 #endif
     int num_failed = 0;
 
+    Long num_skipped = 0;
+    Long num_boxes = 0;
+
 #ifdef _OPENMP
-#pragma omp parallel reduction(+:num_failed)
+#pragma omp parallel reduction(+:num_failed,num_skipped,num_boxes)
 #endif
     for (MFIter mfi(s, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
@@ -202,6 +214,31 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
 
         auto U = s.array(mfi);
         auto reactions = r.array(mfi);
+
+        ++num_boxes;
+
+        if (skip_boxes) {
+            const auto summary = summarize_box(bx, s.const_array(mfi));
+
+            if (summary.T_max < react_T_min || summary.T_min > react_T_max ||
+                summary.rho_max < react_rho_min || summary.rho_min > react_rho_max) {
+
+                // Nothing burns, so all we need to do is what the burn
+                // would do for zones outside the (rho, T) range.
+
+                const Box& rbx = bx & r[mfi].box();
+
+                amrex::ParallelFor(rbx, r.nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    reactions(i,j,k,n) = 0.0_rt;
+                });
+
+                ++num_skipped;
+                continue;
+            }
+        }
+
         auto weights = store_burn_weights ? burn_weights.array(mfi) : Array4<Real>{};
         Array4<Real> empty_arr{};
         const auto& mask = mask_covered_zones ? mask_mf.array(mfi) : empty_arr;
@@ -442,6 +479,10 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
 
     }
 
+    if (verbose && skip_boxes) {
+        report_box_skips("burner", level, num_skipped, num_boxes);
+    }
+
     if (verbose) {
         amrex::Print() << "... Leaving burner on level " << level << " after completing half-timestep of burning." << std::endl << std::endl;
     }
@@ -535,14 +576,24 @@ Castro::react_state(Real time, Real dt)
 
     int burn_success = 1;
 
+    // As in the Strang version, skip the boxes where no zone is in
+    // the (rho, T) range for burning.
+
+    const bool skip_boxes = react_box_skip &&
+                            (react_rho_min >= 1.e-10 || react_rho_max <= 1.e199 ||
+                             react_T_min >= 1.e-10 || react_T_max <= 1.e199);
+
 #if defined(AMREX_USE_GPU)
     Gpu::Buffer<int> d_num_failed({0});
     auto* p_num_failed = d_num_failed.data();
 #endif
     int num_failed = 0;
 
+    Long num_skipped = 0;
+    Long num_boxes = 0;
+
 #ifdef _OPENMP
-#pragma omp parallel reduction(+:num_failed)
+#pragma omp parallel reduction(+:num_failed,num_skipped,num_boxes)
 #endif
     for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
@@ -556,6 +607,30 @@ Castro::react_state(Real time, Real dt)
         auto Bz    = Bz_new.array(mfi);
 #endif
         auto I     = SDC_react.array(mfi);
+
+        ++num_boxes;
+
+        if (skip_boxes) {
+            const auto summary = summarize_box(bx, S_old.const_array(mfi));
+
+            if (summary.T_max < react_T_min || summary.T_min > react_T_max ||
+                summary.rho_max < react_rho_min || summary.rho_min > react_rho_max) {
+
+                // Without burning U_new is left as it is, so q^{n+1} = q*
+                // and the reaction source I_q is zero.  The reactions
+                // were already zeroed above.
+
+                amrex::ParallelFor(bx, NQ,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    I(i,j,k,n) = 0.0_rt;
+                });
+
+                ++num_skipped;
+                continue;
+            }
+        }
+
         auto react_src = reactions.array(mfi);
         auto weights = store_burn_weights ? burn_weights.array(mfi) : Array4<Real>{};
         Array4<Real> empty_arr{};
@@ -850,6 +925,10 @@ Castro::react_state(Real time, Real dt)
 
     }
 
+    if (verbose && skip_boxes) {
+        report_box_skips("burner", level, num_skipped, num_boxes);
+    }
+
     if (verbose) {
 
         amrex::Print() << "... Leaving burner on level " << level << " after completing full timestep of burning." << std::endl << std::endl;
@@ -42,7 +42,10 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
         // for 4th order reacting flow, we need to create the "source" C
         // as averages and then convert it to cell centers.  The cell-center
         // version needs to have 2 ghost cells
-        for (MFIter mfi(*k_new[0]); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(*k_new[0], TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
 
             const Box& bx = mfi.tilebox();
@@ -78,7 +81,9 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
         }
 
         // need to construct the time for this stage -- but it is not really
-        // at a single instance in time.  For single level this does not matter,
+        // at a single instance in time.  For single level this does not matter.
+        // With AMR, the coarse-fine ghost cells get the coarse level's C from
+        // its last stage.  These are only used to convert C to centers.
         Real time = state[SDC_Source_Type].curTime();
         AmrLevel::FillPatch(*this, C_source, C_source.nGrow(), time,
                             SDC_Source_Type, 0, NUM_STATE);
@@ -89,7 +94,10 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
         // staging place so we can do a FillPatch
         MultiFab& S_new = get_new_data(State_Type);
 
-        for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
 
             const Box& bx = mfi.tilebox();
@@ -118,205 +126,236 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
     // main update loop -- we are updating k_new[m_start] to
     // k_new[m_end]
 
-    FArrayBox U_center;
-    FArrayBox C_center;
-    FArrayBox U_new_center;
-    FArrayBox R_new;
-    FArrayBox tlap;
-
-    FArrayBox C2;
+#ifdef REACTIONS
+    // for 4th order, the implicit solve is done on cell-centers,
+    // including one ghost cell, and the reactive source from it is
+    // then converted to averages.  The averaging needs the source on
+    // the neighboring zones, so we store it here rather than redoing
+    // the solve in the ghost cells of every tile.
+    MultiFab R_center;
 
-    for (MFIter mfi(*k_new[0]); mfi.isValid(); ++mfi)
+    if (sdc_order == 4)
     {
+        R_center.define(grids, dmap, NUM_STATE, 1);
 
-        const Box& bx = mfi.tilebox();
-        const Box& bx1 = mfi.growntilebox(1);
-
-#ifdef REACTIONS
-        // advection + reactions
-        if (sdc_order == 2)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
         {
+            FArrayBox U_center;
+            FArrayBox C_center;
+            FArrayBox U_new_center;
 
-            // second order SDC reaction update -- we don't care about
-            // the difference between cell-centers and averages
-
-            // first compute the source term, C -- this differs depending
-            // on whether we are Lobatto or Radau
-            C2.resize(bx, NUM_STATE);
-            Elixir elix_C2 = C2.elixir();
-            Array4<Real> const& C2_arr=C2.array();
-
-            Array4<const Real> const& A_new_arr=(A_new[m_start])->array(mfi);
-            Array4<const Real> const& A_old_0_arr=(A_old[0])->array(mfi);
-            Array4<const Real> const& A_old_1_arr=(A_old[1])->array(mfi);
-            Array4<const Real> const& R_old_0_arr=(R_old[0])->array(mfi);
-            Array4<const Real> const& R_old_1_arr=(R_old[1])->array(mfi);
-
-            if (sdc_quadrature == 0)
+            for (MFIter mfi(*k_new[0], TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
 
-                ca_sdc_compute_C2_lobatto(bx, dt_m, dt, A_new_arr, A_old_0_arr, A_old_1_arr,
-                                          R_old_0_arr, R_old_1_arr, C2_arr, m_start);
-
+                const Box& bx1 = mfi.growntilebox(1);
+
+                // convert the starting U to cell-centered on a fab-by-fab basis
+                // -- including one ghost cell
+                U_center.resize(bx1, NUM_STATE);
+                Elixir elix_u_center = U_center.elixir();
+                auto U_center_arr = U_center.array();
+
+                make_cell_center(bx1, Sborder.array(mfi), U_center_arr, domain_lo, domain_hi);
+
+                // sometimes the Laplacian can make the species go negative near discontinuities
+                amrex::ParallelFor(bx1,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    normalize_species_sdc(i, j, k, U_center_arr);
+                });
+
+                // convert the C source to cell-centers
+                C_center.resize(bx1, NUM_STATE);
+                Elixir elix_c_center = C_center.elixir();
+                auto C_center_arr = C_center.array();
+
+                make_cell_center(bx1, C_source.array(mfi), C_center_arr, domain_lo, domain_hi);
+
+                // solve for the updated cell-center U using our cell-centered C -- we
+                // need to do this with one ghost cell
+                U_new_center.resize(bx1, NUM_STATE);
+                Elixir elix_u_new_center = U_new_center.elixir();
+                auto U_new_center_arr = U_new_center.array();
+
+                // initialize U_new with our guess for the new state, stored as
+                // an average in Sburn
+                make_cell_center(bx1, Sburn.array(mfi), U_new_center_arr, domain_lo, domain_hi);
+
+                amrex::ParallelFor(bx1,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    sdc_update_centers_o4(i, j, k, U_center_arr, U_new_center_arr, C_center_arr, dt_m, sdc_iteration);
+                });
+
+                // enforce that the species sum to one after the reaction solve
+                amrex::ParallelFor(bx1,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    normalize_species_sdc(i, j, k, U_new_center_arr);
+                });
+
+                // compute R_i in the tile and its ghost cell
+                auto const R_center_arr = R_center.array(mfi);
+
+                amrex::ParallelFor(bx1,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    instantaneous_react(i, j, k, U_new_center_arr, R_center_arr);
+                });
             }
-            else
-            {
-
-                Array4<const Real> const& A_old_2_arr=(A_old[2])->array(mfi);
-                Array4<const Real> const& R_old_2_arr=(R_old[2])->array(mfi);
-                ca_sdc_compute_C2_radau(bx, dt_m, dt, A_new_arr, A_old_0_arr, A_old_1_arr,
-                                        A_old_2_arr,
-                                        R_old_0_arr, R_old_1_arr, R_old_2_arr, C2_arr, m_start);
-
-            }
-
-            auto k_m = (*k_new[m_start]).array(mfi);
-            auto k_n = (*k_new[m_end]).array(mfi);
-            auto A_m = (*A_new[m_start]).array(mfi);
-            auto A_n = (*A_new[m_end]).array(mfi);
-            auto C_arr = C2.array();
-
-            amrex::ParallelFor(bx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                sdc_update_o2(i, j, k, k_m, k_n, A_m, A_n, C_arr, dt_m, sdc_iteration, m_start);
-            });
         }
-        else
-        {
+    }
+#endif
 
-            // fourth order SDC reaction update -- we need to respect the
-            // difference between cell-centers and averages
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
 
-            Array4<const Real> const& k_new_m_start_arr=
-                (k_new[m_start])->array(mfi);
-            Array4<Real> const& k_new_m_end_arr=(k_new[m_end])->array(mfi);
-            Array4<const Real> const& C_source_arr=C_source.array(mfi);
+        FArrayBox R_new;
+        FArrayBox C2;
 
-            // convert the starting U to cell-centered on a fab-by-fab basis
-            // -- including one ghost cell
-            U_center.resize(bx1, NUM_STATE);
-            Elixir elix_u_center = U_center.elixir();
-            auto U_center_arr = U_center.array();
+        for (MFIter mfi(*k_new[0], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
 
-            make_cell_center(bx1, Sborder.array(mfi), U_center_arr, domain_lo, domain_hi);
+            const Box& bx = mfi.tilebox();
 
-            // sometimes the Laplacian can make the species go negative near discontinuities
-            amrex::ParallelFor(bx1,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+#ifdef REACTIONS
+            // advection + reactions
+            if (sdc_order == 2)
             {
-                normalize_species_sdc(i, j, k, U_center_arr);
-            });
-
-            // convert the C source to cell-centers
-            C_center.resize(bx1, NUM_STATE);
-            Elixir elix_c_center = C_center.elixir();
-            auto C_center_arr = C_center.array();
 
-            make_cell_center(bx1, C_source.array(mfi), C_center_arr, domain_lo, domain_hi);
-
-            // solve for the updated cell-center U using our cell-centered C -- we
-            // need to do this with one ghost cell
-            U_new_center.resize(bx1, NUM_STATE);
-            Elixir elix_u_new_center = U_new_center.elixir();
-            auto U_new_center_arr = U_new_center.array();
-
-            // initialize U_new with our guess for the new state, stored as
-            // an average in Sburn
-            make_cell_center(bx1, Sburn.array(mfi), U_new_center_arr, domain_lo, domain_hi);
-
-            amrex::ParallelFor(bx1,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                // second order SDC reaction update -- we don't care about
+                // the difference between cell-centers and averages
+
+                // first compute the source term, C -- this differs depending
+                // on whether we are Lobatto or Radau
+                C2.resize(bx, NUM_STATE);
+                Elixir elix_C2 = C2.elixir();
+                Array4<Real> const& C2_arr=C2.array();
+
+                Array4<const Real> const& A_new_arr=(A_new[m_start])->array(mfi);
+                Array4<const Real> const& A_old_0_arr=(A_old[0])->array(mfi);
+                Array4<const Real> const& A_old_1_arr=(A_old[1])->array(mfi);
+                Array4<const Real> const& R_old_0_arr=(R_old[0])->array(mfi);
+                Array4<const Real> const& R_old_1_arr=(R_old[1])->array(mfi);
+
+                if (sdc_quadrature == 0)
+                {
+
+                    ca_sdc_compute_C2_lobatto(bx, dt_m, dt, A_new_arr, A_old_0_arr, A_old_1_arr,
+                                              R_old_0_arr, R_old_1_arr, C2_arr, m_start);
+
+                }
+                else
+                {
+
+                    Array4<const Real> const& A_old_2_arr=(A_old[2])->array(mfi);
+                    Array4<const Real> const& R_old_2_arr=(R_old[2])->array(mfi);
+                    ca_sdc_compute_C2_radau(bx, dt_m, dt, A_new_arr, A_old_0_arr, A_old_1_arr,
+                                            A_old_2_arr,
+                                            R_old_0_arr, R_old_1_arr, R_old_2_arr, C2_arr, m_start);
+
+                }
+
+                auto k_m = (*k_new[m_start]).array(mfi);
+                auto k_n = (*k_new[m_end]).array(mfi);
+                auto A_m = (*A_new[m_start]).array(mfi);
+                auto A_n = (*A_new[m_end]).array(mfi);
+                auto C_arr = C2.array();
+
+                amrex::ParallelFor(bx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    sdc_update_o2(i, j, k, k_m, k_n, A_m, A_n, C_arr, dt_m, sdc_iteration, m_start);
+                });
+            }
+            else
             {
-                sdc_update_centers_o4(i, j, k, U_center_arr, U_new_center_arr, C_center_arr, dt_m, sdc_iteration);
-            });
 
-            // enforce that the species sum to one after the reaction solve
-            amrex::ParallelFor(bx1,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                normalize_species_sdc(i, j, k, U_new_center_arr);
-            });
+                // fourth order SDC reaction update -- we need to respect the
+                // difference between cell-centers and averages
 
-            // compute R_i and in 1 ghost cell and then convert to <R> in
-            // place (only for the interior)
-            R_new.resize(bx1, NUM_STATE);
-            Elixir elix_R_new = R_new.elixir();
-            Array4<Real> const& R_new_arr = R_new.array();
+                Array4<const Real> const& k_new_m_start_arr=
+                    (k_new[m_start])->array(mfi);
+                Array4<Real> const& k_new_m_end_arr=(k_new[m_end])->array(mfi);
+                Array4<const Real> const& C_source_arr=C_source.array(mfi);
 
-            amrex::ParallelFor(bx1,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                instantaneous_react(i, j, k, U_new_center_arr, R_new_arr);
-            });
+                // convert R_i to <R> on the tile -- this is done out of place
+                // since R_center is shared with the neighboring tiles
+                R_new.resize(bx, NUM_STATE);
+                Elixir elix_R_new = R_new.elixir();
+                Array4<Real> const& R_new_arr = R_new.array();
 
-            tlap.resize(bx, 1);
-            Elixir elix_tlap = tlap.elixir();
-            auto const tlap_arr = tlap.array();
+                R_new.copy<RunOn::Device>(R_center[mfi], bx, 0, bx, 0, NUM_STATE);
 
-            make_fourth_in_place(bx, R_new_arr, tlap_arr, domain_lo, domain_hi);
+                make_fourth_average(bx, R_new_arr, R_center.const_array(mfi), domain_lo, domain_hi);
 
-            // now do the conservative update using this <R> to get <U>
-            // We'll also need to pass in <C>
-            ca_sdc_conservative_update(bx, dt_m, k_new_m_start_arr, k_new_m_end_arr,
-                                       C_source_arr, R_new_arr);
+                // now do the conservative update using this <R> to get <U>
+                // We'll also need to pass in <C>
+                ca_sdc_conservative_update(bx, dt_m, k_new_m_start_arr, k_new_m_end_arr,
+                                           C_source_arr, R_new_arr);
 
-        }
+            }
 #else
-        Array4<const Real> const& k_new_m_start_arr=
-            (k_new[m_start])->array(mfi);
-        Array4<Real> const& k_new_m_end_arr=(k_new[m_end])->array(mfi);
-        Array4<const Real> const& A_new_arr=(A_new[m_start])->array(mfi);
-        Array4<const Real> const& A_old_0_arr=(A_old[0])->array(mfi);
-        Array4<const Real> const& A_old_1_arr=(A_old[1])->array(mfi);
-        // pure advection
-        if (sdc_order == 2)
-        {
-
-            if (sdc_quadrature == 0)
+            Array4<const Real> const& k_new_m_start_arr=
+                (k_new[m_start])->array(mfi);
+            Array4<Real> const& k_new_m_end_arr=(k_new[m_end])->array(mfi);
+            Array4<const Real> const& A_new_arr=(A_new[m_start])->array(mfi);
+            Array4<const Real> const& A_old_0_arr=(A_old[0])->array(mfi);
+            Array4<const Real> const& A_old_1_arr=(A_old[1])->array(mfi);
+            // pure advection
+            if (sdc_order == 2)
             {
-                ca_sdc_update_advection_o2_lobatto(bx, dt_m, dt, k_new_m_start_arr,
-                                                   k_new_m_end_arr,
-                                                   A_new_arr, A_old_0_arr, A_old_1_arr,
-                                                   m_start);
 
-            }
-            else
-            {
-                Array4<const Real> const& A_old_2_arr=(A_old[2])->array(mfi);
-                ca_sdc_update_advection_o2_radau(bx, dt_m, dt, k_new_m_start_arr,
-                                                 k_new_m_end_arr,
-                                                 A_new_arr, A_old_0_arr, A_old_1_arr, A_old_2_arr,
-                                                 m_start);
+                if (sdc_quadrature == 0)
+                {
+                    ca_sdc_update_advection_o2_lobatto(bx, dt_m, dt, k_new_m_start_arr,
+                                                       k_new_m_end_arr,
+                                                       A_new_arr, A_old_0_arr, A_old_1_arr,
+                                                       m_start);
 
-            }
+                }
+                else
+                {
+                    Array4<const Real> const& A_old_2_arr=(A_old[2])->array(mfi);
+                    ca_sdc_update_advection_o2_radau(bx, dt_m, dt, k_new_m_start_arr,
+                                                     k_new_m_end_arr,
+                                                     A_new_arr, A_old_0_arr, A_old_1_arr, A_old_2_arr,
+                                                     m_start);
 
-        }
-        else
-        {
-            Array4<const Real> const& A_old_2_arr=(A_old[2])->array(mfi);
-            if (sdc_quadrature == 0)
-            {
-                ca_sdc_update_advection_o4_lobatto(bx, dt_m, dt, k_new_m_start_arr,
-                                                   k_new_m_end_arr,
-                                                   A_new_arr, A_old_0_arr, A_old_1_arr, A_old_2_arr,
-                                                   m_start);
+                }
 
             }
             else
             {
-                Array4<const Real> const& A_old_3_arr=(A_old[3])->array(mfi);
-                ca_sdc_update_advection_o4_radau(bx, dt_m, dt, k_new_m_start_arr,
-                                                 k_new_m_end_arr,
-                                                 A_new_arr, A_old_0_arr, A_old_1_arr, A_old_2_arr,
-                                                 A_old_3_arr, m_start);
+                Array4<const Real> const& A_old_2_arr=(A_old[2])->array(mfi);
+                if (sdc_quadrature == 0)
+                {
+                    ca_sdc_update_advection_o4_lobatto(bx, dt_m, dt, k_new_m_start_arr,
+                                                       k_new_m_end_arr,
+                                                       A_new_arr, A_old_0_arr, A_old_1_arr, A_old_2_arr,
+                                                       m_start);
+
+                }
+                else
+                {
+                    Array4<const Real> const& A_old_3_arr=(A_old[3])->array(mfi);
+                    ca_sdc_update_advection_o4_radau(bx, dt_m, dt, k_new_m_start_arr,
+                                                     k_new_m_end_arr,
+                                                     A_new_arr, A_old_0_arr, A_old_1_arr, A_old_2_arr,
+                                                     A_old_3_arr, m_start);
+
+                }
 
             }
+#endif
 
         }
-#endif
 
-    }
+    } // OMP loop
 }
 
 
@@ -334,67 +373,80 @@ Castro::construct_old_react_source(MultiFab& U_state,
 
     if (sdc_order == 4 && input_is_average)
     {
-        // we have cell-averages
-        // Note: we cannot tile these operations
+        // we have cell-averages.  We first compute the reactive
+        // source on centers, including one ghost cell, and then
+        // convert it to averages in a second pass, since the averaging
+        // needs the source on the neighboring tiles.  Note: U_state may
+        // be Sburn, so we can't store the centered source there until
+        // we are done with U_state.
 
-        FArrayBox U_center;
-        FArrayBox R_center;
-        FArrayBox tmp;
+        MultiFab R_center(grids, dmap, NUM_STATE, 1);
 
-        for (MFIter mfi(U_state); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
         {
+            FArrayBox U_center;
 
-            const Box& bx = mfi.tilebox();
-            const Box& obx = mfi.growntilebox(1);
+            for (MFIter mfi(U_state, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
 
-            // Convert to centers
-            U_center.resize(obx, NUM_STATE);
-            Elixir elix_u_center = U_center.elixir();
-            auto const U_center_arr = U_center.array();
+                const Box& obx = mfi.growntilebox(1);
 
-            make_cell_center(obx, U_state.array(mfi), U_center_arr, domain_lo, domain_hi);
+                // Convert to centers
+                U_center.resize(obx, NUM_STATE);
+                Elixir elix_u_center = U_center.elixir();
+                auto const U_center_arr = U_center.array();
 
-            // sometimes the Laplacian can make the species go negative near discontinuities
-            amrex::ParallelFor(obx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                normalize_species_sdc(i, j, k, U_center_arr);
-            });
+                make_cell_center(obx, U_state.array(mfi), U_center_arr, domain_lo, domain_hi);
 
-            // burn, including one ghost cell
-            R_center.resize(obx, NUM_STATE);
-            Elixir elix_r_center = R_center.elixir();
-            auto const R_center_arr = R_center.array();
+                // sometimes the Laplacian can make the species go negative near discontinuities
+                amrex::ParallelFor(obx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    normalize_species_sdc(i, j, k, U_center_arr);
+                });
 
-            amrex::ParallelFor(obx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                instantaneous_react(i, j, k, U_center_arr, R_center_arr);
-            });
+                // burn, including one ghost cell
+                auto const R_center_arr = R_center.array(mfi);
+
+                amrex::ParallelFor(obx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    instantaneous_react(i, j, k, U_center_arr, R_center_arr);
+                });
+            }
+        }
 
-            // at this point, we have the reaction term on centers,
-            // including a ghost cell.  Save this into Sburn so we can use
-            // it later for the plotfile filling
-            Sburn[mfi].copy(R_center, obx, 0, obx, 0, NUM_STATE);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(R_source, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
 
-            // convert R to averages (in place)
+            const Box& bx = mfi.tilebox();
 
-            tmp.resize(bx, 1);
-            Elixir elix_tmp = tmp.elixir();
-            auto const tmp_arr = tmp.array();
+            // convert R to averages
 
-            make_fourth_in_place(bx, R_center_arr, tmp_arr, domain_lo, domain_hi);
+            R_source[mfi].copy<RunOn::Device>(R_center[mfi], bx, 0, bx, 0, NUM_STATE);
 
-            // copy this to the center
-            R_source[mfi].copy(R_center, bx, 0, bx, 0, NUM_STATE);
+            make_fourth_average(bx, R_source.array(mfi), R_center.const_array(mfi), domain_lo, domain_hi);
         }
 
+        // at this point, we have the reaction term on centers,
+        // including a ghost cell.  Save this into Sburn so we can use
+        // it later for the plotfile filling
+        MultiFab::Copy(Sburn, R_center, 0, 0, NUM_STATE, 1);
+
     }
     else
     {
         // we are cell-centers
 
-        for (MFIter mfi(U_state); mfi.isValid(); ++mfi)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(U_state, TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
 
             const Box& bx = mfi.tilebox();
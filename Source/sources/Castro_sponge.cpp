@@ -1,5 +1,6 @@
 #ifdef SPONGE
 #include <Castro.H>
+#include <box_summary.H>
 
 #ifdef HYBRID_MOMENTUM
 #include <hybrid.H>
@@ -34,16 +35,71 @@ Castro::construct_new_sponge_source(MultiFab& source, MultiFab& state_old, Multi
         return;
     }
 
+    // The sponge does nothing where the sponge factor is zero.  With
+    // sponge_lower_factor = 0 that is the region inside
+    // sponge_lower_radius, or above sponge_upper_density if the
+    // density sponge is used (it takes priority over the radial one),
+    // and we can check this for a whole box at once.  We cannot bound
+    // the pressure of a box without an EOS call in every zone, so
+    // there is no box skipping with the pressure sponge.
+
+    const bool use_radial = sponge_lower_radius >= 0.0_rt && sponge_upper_radius > sponge_lower_radius;
+    const bool use_density = sponge_upper_density > 0.0_rt && sponge_lower_density > 0.0_rt;
+    const bool use_pressure = sponge_upper_pressure > 0.0_rt && sponge_lower_pressure >= 0.0_rt;
+
+    const bool skip_boxes = sponge_box_skip && sponge_lower_factor == 0.0_rt && !use_pressure;
+
+    const auto dx = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+
+    Long num_skipped = 0;
+    Long num_boxes = 0;
+
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel reduction(+:num_skipped,num_boxes)
 #endif
     for (MFIter mfi(state_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
         const Box& bx = mfi.tilebox();
 
+        ++num_boxes;
+
+        if (skip_boxes) {
+            bool inactive;
+
+            if (use_density) {
+                const auto summary = summarize_box(bx, state_new.const_array(mfi));
+                inactive = summary.rho_min > sponge_upper_density;
+            }
+            else if (use_radial) {
+                // the largest distance from the center of a zone center in this box
+                Real rad_max = 0.0_rt;
+                for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
+                    Real r_lo = problo[idir] + (static_cast<Real>(bx.smallEnd(idir)) + 0.5_rt) * dx[idir] - problem::center[idir];
+                    Real r_hi = problo[idir] + (static_cast<Real>(bx.bigEnd(idir)) + 0.5_rt) * dx[idir] - problem::center[idir];
+                    Real r_max = amrex::max(std::abs(r_lo), std::abs(r_hi));
+                    rad_max += r_max * r_max;
+                }
+                inactive = std::sqrt(rad_max) < sponge_lower_radius;
+            }
+            else {
+                // no sponge region is defined, so the factor is zero everywhere
+                inactive = true;
+            }
+
+            if (inactive) {
+                ++num_skipped;
+                continue;
+            }
+        }
+
         apply_sponge(bx, state_new.array(mfi), source.array(mfi), dt);
     }
 
+    if (verbose > 1 && skip_boxes) {
+        report_box_skips("sponge", level, num_skipped, num_boxes);
+    }
+
     if (verbose > 1)
     {
         const int IOProc   = ParallelDescriptor::IOProcessorNumber();
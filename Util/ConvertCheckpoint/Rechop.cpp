@@ -0,0 +1,577 @@
+
+// This reads a Checkpoint file and writes it out again with the grids
+// on each level re-chopped to a new max_grid_size / blocking_factor,
+// for restarting on a different number of ranks.  The data is streamed
+// one FAB at a time, so no level is ever held in memory.
+// ---------------------------------------------------------------
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+#include <string>
+
+#include <AMReX_REAL.H>
+#include <AMReX_Box.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_LevelBld.H>
+
+using namespace amrex;
+
+LevelBld *getLevelBld() {
+  return 0;
+}
+
+using std::cout;
+using std::endl;
+
+std::string CheckFileIn;
+std::string CheckFileOut;
+int nFiles(64);
+bool verbose(true);
+Vector<int> max_grid_size;
+Vector<int> blocking_factor(1, 1);
+int nprocs_target(0);
+int fab_cache_size(8);
+const std::string CheckPointVersion = "CheckPointVersion_1.0";
+
+// ---------------------------------------------------------------
+static void PrintUsage (char *progName) {
+    cout << "Usage: " << progName << " checkin=filename "
+         << "checkout=outfilename "
+         << "max_grid_size=n [n1 n2 ...] "
+         << "[blocking_factor=n [n1 n2 ...]] "
+         << "[nprocs_target=n] "
+         << "[nfiles=nfilesout] "
+         << "[fab_cache_size=n] "
+         << "[verbose=trueorfalse]" << endl;
+    exit(1);
+}
+
+// ---------------------------------------------------------------
+static void ScanArguments() {
+    ParmParse pp;
+
+    pp.get("checkin", CheckFileIn);
+    pp.get("checkout", CheckFileOut);
+    pp.getarr("max_grid_size", max_grid_size);
+    pp.queryarr("blocking_factor", blocking_factor);
+    pp.query("nprocs_target", nprocs_target);
+    pp.query("nfiles", nFiles);
+    pp.query("fab_cache_size", fab_cache_size);
+    pp.query("verbose", verbose);
+
+    if (CheckFileIn == CheckFileOut)
+        amrex::Abort("checkout must be different from checkin");
+
+    for (int n : max_grid_size)
+        if (n <= 0) amrex::Abort("max_grid_size must be positive");
+
+    for (int n : blocking_factor)
+        if (n <= 0) amrex::Abort("blocking_factor must be positive");
+
+    if (fab_cache_size < 1)
+        amrex::Abort("must have fab_cache_size >= 1");
+}
+
+// the value for a level of a parameter that may be given per level
+static int LevelValue(const Vector<int>& v, int lev) {
+    return v[std::min(lev, static_cast<int>(v.size()) - 1)];
+}
+
+// ---------------------------------------------------------------
+//
+// Re-chop the grids of a level.  The region they cover is unchanged;
+// the new boxes are at most max_grid_size long and are aligned with
+// (and multiples of) the blocking factor.
+//
+static BoxArray RechopGrids(const BoxArray& grids, int lev) {
+    const int bf = LevelValue(blocking_factor, lev);
+    const int mgs = LevelValue(max_grid_size, lev);
+
+    if (mgs % bf != 0)
+        amrex::Abort("max_grid_size must be a multiple of blocking_factor");
+
+    if ( ! grids.coarsenable(bf))
+        amrex::Abort("the grids on level " + std::to_string(lev) +
+                     " are not coarsenable by blocking_factor " + std::to_string(bf));
+
+    BoxList bl(amrex::coarsen(grids, bf).boxList());
+    bl.simplify();
+
+    BoxArray new_grids(bl);
+
+    // If we know how many ranks we will restart on, keep splitting until
+    // there is at least one box per rank (or we reach the blocking factor).
+
+    int len = mgs / bf;
+    new_grids.maxSize(len);
+
+    while (new_grids.size() < nprocs_target && len > 1) {
+        len /= 2;
+        new_grids = BoxArray(bl);
+        new_grids.maxSize(len);
+    }
+
+    new_grids.refine(bf);
+
+    return new_grids;
+}
+
+// ---------------------------------------------------------------
+//
+// The FABs of the old MultiFab that this rank has read most recently.
+//
+class FabCache {
+public:
+    FabCache (VisMF& vmf, const std::string& mf_name, int capacity)
+        : m_vmf(vmf), m_mf_name(mf_name), m_capacity(capacity) {}
+
+    const FArrayBox& get (int idx) {
+        auto it = m_fabs.find(idx);
+        if (it != m_fabs.end()) {
+            m_order.remove(idx);
+            m_order.push_front(idx);
+            return *it->second;
+        }
+
+        if (static_cast<int>(m_fabs.size()) >= m_capacity) {
+            m_fabs.erase(m_order.back());
+            m_order.pop_back();
+        }
+
+        m_order.push_front(idx);
+        auto& fab = m_fabs[idx];
+        fab.reset(m_vmf.readFAB(idx, m_mf_name));
+        return *fab;
+    }
+
+private:
+    VisMF& m_vmf;
+    std::string m_mf_name;
+    int m_capacity;
+    std::map<int, std::unique_ptr<FArrayBox>> m_fabs;
+    std::list<int> m_order;
+};
+
+// ---------------------------------------------------------------
+//
+// Write the MultiFab in_name on the new grids as out_name, one FAB at
+// a time.  The FABs are laid out in the data files in the same way as
+// VisMF::Write would with OneFilePerCPU and nfiles files.
+//
+static void RechopMultiFab(const std::string& in_name, const std::string& out_name,
+                           const BoxArray& new_cc_grids) {
+    BL_PROFILE("RechopMultiFab()");
+
+    VisMF vmf(in_name);
+
+    const BoxArray& old_ba = vmf.boxArray();
+    const int ncomp = vmf.nComp();
+    const int ngrow = vmf.nGrow();
+
+    BoxArray old_grown(old_ba);
+    old_grown.grow(ngrow);
+
+    const BoxArray new_ba = amrex::convert(new_cc_grids, old_ba.ixType());
+    const DistributionMapping dm(new_ba);
+
+    const int nfabs = static_cast<int>(new_ba.size());
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
+    const int nfiles = std::max(1, std::min(nFiles, nprocs));
+
+    auto file_number = [=] (int proc) -> int {
+        return static_cast<int>(static_cast<Long>(proc) * nfiles / nprocs);
+    };
+
+    std::string mf_base = out_name;
+    std::string mf_dir;
+    if (auto slash = out_name.rfind('/'); slash != std::string::npos) {
+        mf_base = out_name.substr(slash + 1);
+        mf_dir = out_name.substr(0, slash + 1);
+    }
+
+    auto file_name = [&] (int f) -> std::string {
+        return amrex::Concatenate(mf_base + "_D_", f, 5);
+    };
+
+    const FABio& fabio = FArrayBox::getFABio();
+
+    Long value_bytes = 0;
+    {
+        FArrayBox probe(Box(IntVect(0), IntVect(0)), 1);
+        probe.setVal<RunOn::Host>(0.0);
+
+        std::ostringstream ss;
+        fabio.write(ss, probe, 0, 1);
+        value_bytes = static_cast<Long>(ss.str().size());
+    }
+
+    // Every rank works out where every FAB goes: within a file the FABs
+    // are ordered by rank and then by index.
+
+    Vector<std::string> fab_header(nfabs);
+    Vector<Long> fab_offset(nfabs);
+
+    Vector<int> order(nfabs);
+    for (int i = 0; i < nfabs; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&] (int a, int b) { return dm[a] < dm[b]; });
+
+    Vector<Long> file_end(nfiles, 0);
+
+    for (int i : order) {
+        const Box bx = amrex::grow(new_ba[i], ngrow);
+
+        std::ostringstream ss;
+        fabio.write_header(ss, FArrayBox(bx, ncomp, false), ncomp);
+        fab_header[i] = ss.str();
+
+        const int f = file_number(dm[i]);
+        fab_offset[i] = file_end[f];
+        file_end[f] += static_cast<Long>(fab_header[i].size()) +
+                       static_cast<Long>(ncomp) * bx.numPts() * value_bytes;
+    }
+
+    const std::string my_file_name = mf_dir + file_name(file_number(myproc));
+
+    if (myproc == 0 || file_number(myproc - 1) != file_number(myproc)) {
+        std::ofstream ofs(my_file_name, std::ios::out | std::ios::trunc | std::ios::binary);
+        if ( ! ofs.good()) {
+            amrex::FileOpenFailed(my_file_name);
+        }
+    }
+
+    ParallelDescriptor::Barrier();
+
+    std::fstream fs(my_file_name, std::ios::in | std::ios::out | std::ios::binary);
+    if ( ! fs.good()) {
+        amrex::FileOpenFailed(my_file_name);
+    }
+
+    Vector<Real> fab_min(static_cast<Long>(nfabs) * ncomp, 0.0);
+    Vector<Real> fab_max(static_cast<Long>(nfabs) * ncomp, 0.0);
+
+    FabCache cache(vmf, in_name, fab_cache_size);
+
+    for (int i = 0; i < nfabs; ++i) {
+        if (dm[i] != myproc) continue;
+
+        const Box& vbx = new_ba[i];
+        const Box bx = amrex::grow(vbx, ngrow);
+
+        FArrayBox fab(bx, ncomp);
+        fab.setVal<RunOn::Host>(0.0);
+
+        // Ghost zones first, from whatever old FAB (valid or ghost zones)
+        // covers them, and then the valid data on top.
+
+        for (const auto& isect : old_grown.intersections(bx)) {
+            const FArrayBox& old_fab = cache.get(isect.first);
+            fab.copy<RunOn::Host>(old_fab, isect.second, 0, isect.second, 0, ncomp);
+        }
+
+        for (const auto& isect : old_ba.intersections(bx)) {
+            const FArrayBox& old_fab = cache.get(isect.first);
+            fab.copy<RunOn::Host>(old_fab, isect.second, 0, isect.second, 0, ncomp);
+        }
+
+        for (int n = 0; n < ncomp; ++n) {
+            fab_min[static_cast<Long>(i) * ncomp + n] = fab.min<RunOn::Host>(vbx, n);
+            fab_max[static_cast<Long>(i) * ncomp + n] = fab.max<RunOn::Host>(vbx, n);
+        }
+
+        fs.seekp(fab_offset[i]);
+        fs.write(fab_header[i].data(), static_cast<std::streamsize>(fab_header[i].size()));
+        fabio.write(fs, fab, 0, ncomp);
+    }
+
+    fs.close();
+    if (fs.fail()) {
+        amrex::Error("Rechop: failed writing " + my_file_name);
+    }
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+    ParallelDescriptor::ReduceRealSum(fab_min.data(), static_cast<int>(fab_min.size()), IOProc);
+    ParallelDescriptor::ReduceRealSum(fab_max.data(), static_cast<int>(fab_max.size()), IOProc);
+
+    if (ParallelDescriptor::IOProcessor()) {
+
+        VisMF::Header hdr;
+
+        hdr.m_vers = VisMF::Header::Version_v1;
+        hdr.m_how = VisMF::OneFilePerCPU;
+        hdr.m_ncomp = ncomp;
+        hdr.m_ngrow = IntVect(ngrow);
+        hdr.m_ba = new_ba;
+
+        hdr.m_fod.resize(nfabs);
+        hdr.m_min.resize(nfabs);
+        hdr.m_max.resize(nfabs);
+
+        for (int i = 0; i < nfabs; ++i) {
+            hdr.m_fod[i] = VisMF::FabOnDisk(file_name(file_number(dm[i])), fab_offset[i]);
+
+            hdr.m_min[i].assign(fab_min.begin() + static_cast<Long>(i) * ncomp,
+                                fab_min.begin() + static_cast<Long>(i + 1) * ncomp);
+            hdr.m_max[i].assign(fab_max.begin() + static_cast<Long>(i) * ncomp,
+                                fab_max.begin() + static_cast<Long>(i + 1) * ncomp);
+        }
+
+        const std::string header_name = out_name + "_H";
+
+        std::ofstream hfile(header_name);
+        if ( ! hfile.good()) {
+            amrex::FileOpenFailed(header_name);
+        }
+
+        hfile << hdr;
+        hfile.close();
+    }
+
+    ParallelDescriptor::Barrier();
+}
+
+// ---------------------------------------------------------------
+//
+// Copy everything in the old checkpoint except the main Header and the
+// level data (CastroHeader, dtHeader, particles, ...).
+//
+static void CopyAuxiliaryFiles() {
+    namespace fs = std::filesystem;
+
+    if (ParallelDescriptor::IOProcessor()) {
+        for (const auto& entry : fs::directory_iterator(CheckFileIn)) {
+            const std::string name = entry.path().filename().string();
+
+            if (name == "Header" || name.rfind("Level_", 0) == 0) continue;
+
+            fs::copy(entry.path(), fs::path(CheckFileOut) / name,
+                     fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+        }
+    }
+
+    ParallelDescriptor::Barrier();
+}
+
+// ---------------------------------------------------------------
+//
+// Read the old Header, and write the new one as we go, with the grids
+// of each level (and of its StateData) replaced by the re-chopped ones.
+// The MultiFabs are written out level by level.
+//
+static void RechopCheckpoint() {
+
+    std::string InFile = CheckFileIn + "/Header";
+    std::string OutFile = CheckFileOut + "/Header";
+
+    std::ifstream is(InFile.c_str(), std::ios::in);
+    if ( ! is.good()) {
+        amrex::FileOpenFailed(InFile);
+    }
+
+    std::ofstream os;
+    if (ParallelDescriptor::IOProcessor()) {
+        os.open(OutFile.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+        if ( ! os.good()) {
+            amrex::FileOpenFailed(OutFile);
+        }
+        os.precision(17);
+    }
+
+    std::string first_line;
+    std::getline(is, first_line);
+
+    if (first_line != CheckPointVersion) {
+        amrex::Abort("Rechop only handles checkpoints of version " + CheckPointVersion);
+    }
+
+    int spdim;
+    Real cumtime;
+    int max_level, finest_level;
+    is >> spdim >> cumtime >> max_level >> finest_level;
+
+    if (spdim != AMREX_SPACEDIM) {
+        amrex::Abort("bad spacedim = " + std::to_string(spdim));
+    }
+
+    Vector<Geometry> geom(max_level + 1);
+    Vector<IntVect> ref_ratio(max_level);
+    Vector<Real> dt_level(max_level + 1), dt_min(max_level + 1);
+    Vector<int> n_cycle(max_level + 1), level_steps(max_level + 1), level_count(max_level + 1);
+
+    for (auto& g : geom) is >> g;
+    for (auto& r : ref_ratio) is >> r;
+    for (auto& d : dt_level) is >> d;
+    for (auto& d : dt_min) is >> d;
+    for (auto& n : n_cycle) is >> n;
+    for (auto& n : level_steps) is >> n;
+    for (auto& n : level_count) is >> n;
+
+    if (ParallelDescriptor::IOProcessor()) {
+        os << CheckPointVersion << '\n'
+           << AMREX_SPACEDIM << '\n'
+           << cumtime << '\n'
+           << max_level << '\n'
+           << finest_level << '\n';
+
+        for (const auto& g : geom) os << g << ' ';
+        os << '\n';
+        for (const auto& r : ref_ratio) os << r << ' ';
+        os << '\n';
+        for (auto d : dt_level) os << d << ' ';
+        os << '\n';
+        for (auto d : dt_min) os << d << ' ';
+        os << '\n';
+        for (auto n : n_cycle) os << n << ' ';
+        os << '\n';
+        for (auto n : level_steps) os << n << ' ';
+        os << '\n';
+        for (auto n : level_count) os << n << ' ';
+        os << '\n';
+    }
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+
+        int level;
+        Geometry level_geom;
+        BoxArray grids;
+        int ndesc;
+
+        is >> level;
+        if (is.fail() || level != lev) {
+            amrex::Abort("could not read level " + std::to_string(lev) + " of the Header; "
+                         "checkpoints with extra per-level data (e.g. radiation) are not supported");
+        }
+
+        is >> level_geom;
+        grids.readFrom(is);
+        is >> ndesc;
+
+        const BoxArray new_grids = RechopGrids(grids, lev);
+
+        if (verbose && ParallelDescriptor::IOProcessor()) {
+            cout << "Level " << lev << ": " << grids.size() << " grids -> "
+                 << new_grids.size() << " grids" << endl;
+        }
+
+        const std::string FullPath = CheckFileOut + "/Level_" + std::to_string(lev);
+
+        if (ParallelDescriptor::IOProcessor()) {
+            if ( ! amrex::UtilCreateDirectory(FullPath, 0755)) {
+                amrex::CreateDirectoryFailed(FullPath);
+            }
+
+            os << lev << '\n' << level_geom << '\n';
+            new_grids.writeOn(os);
+            os << ndesc << '\n';
+        }
+
+        ParallelDescriptor::Barrier();
+
+        for (int i = 0; i < ndesc; ++i) {
+
+            Box domain;
+            BoxArray state_grids;
+            Real old_start, old_stop, new_start, new_stop;
+            int nsets;
+
+            is >> domain;
+            state_grids.readFrom(is);
+            is >> old_start >> old_stop >> new_start >> new_stop >> nsets;
+
+            // face-centered StateData (the MHD magnetic field) stores its
+            // grids with its own index type
+
+            if (amrex::convert(state_grids, IndexType::TheCellType()) != grids) {
+                amrex::Abort("the StateData grids differ from the level grids");
+            }
+
+            Vector<std::string> mf_names(nsets);
+            for (auto& name : mf_names) is >> name;
+
+            if (ParallelDescriptor::IOProcessor()) {
+                os << domain << '\n';
+                amrex::convert(new_grids, state_grids.ixType()).writeOn(os);
+                os << old_start << '\n'
+                   << old_stop << '\n'
+                   << new_start << '\n'
+                   << new_stop << '\n';
+                os << nsets << '\n';
+                for (const auto& name : mf_names) os << name << '\n';
+            }
+
+            // The names are relative to the checkpoint directory, so the
+            // new MultiFabs have the same names in the new checkpoint.
+
+            for (const auto& name : mf_names) {
+                if (verbose && ParallelDescriptor::IOProcessor()) {
+                    cout << "  ... " << name << endl;
+                }
+                RechopMultiFab(CheckFileIn + "/" + name, CheckFileOut + "/" + name, new_grids);
+            }
+        }
+    }
+
+    if (ParallelDescriptor::IOProcessor()) {
+        os.close();
+        if (os.fail()) {
+            amrex::Error("Rechop: failed writing " + OutFile);
+        }
+    }
+}
+
+// ---------------------------------------------------------------
+int main(int argc, char *argv[]) {
+    amrex::Initialize(argc,argv);
+
+    if(argc < 4) {
+      PrintUsage(argv[0]);
+    }
+
+    ScanArguments();
+
+    // In checkpoint files always write out FABs in NATIVE format.
+    FArrayBox::setFormat(FABio::FAB_NATIVE);
+
+    if(verbose && ParallelDescriptor::IOProcessor()) {
+      cout << " " << std::endl;
+      cout << "Re-chopping checkpoint file: " << CheckFileIn << endl;
+      cout << " " << std::endl;
+    }
+
+    if(ParallelDescriptor::IOProcessor()) {
+      if( ! amrex::UtilCreateDirectory(CheckFileOut, 0755)) {
+        amrex::CreateDirectoryFailed(CheckFileOut);
+      }
+    }
+    ParallelDescriptor::Barrier();
+
+    CopyAuxiliaryFiles();
+
+    RechopCheckpoint();
+
+    if(verbose && ParallelDescriptor::IOProcessor()) {
+      cout << " " << std::endl;
+      cout << "Finished writing to new checkpoint file: " << CheckFileOut << endl;
+      cout << " " << std::endl;
+    }
+
+    amrex::Finalize();
+}
+// ---------------------------------------------------------------
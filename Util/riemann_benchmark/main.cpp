@@ -0,0 +1,198 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <extern_parameters.H>
+#include <prob_parameters.H>
+#include <eos.H>
+#include <network.H>
+
+#include <castro_params.H>
+#include <state_indices.H>
+
+using namespace castro;
+
+#include <riemann_type.H>
+#include <riemann_2shock_solvers.H>
+#include <riemann_batch.H>
+
+using namespace amrex::literals;
+
+namespace {
+
+    // time nreps passes of solver over all of the batches and return
+    // the number of interfaces solved per second
+
+    template <typename F>
+    amrex::Real
+    time_solver(const std::string& name, F&& solver, const int ntot)
+    {
+        // warm up (this also brings the states into cache)
+        solver();
+
+        amrex::Real t0 = amrex::ParallelDescriptor::second();
+        for (int rep = 0; rep < problem::nreps; ++rep) {
+            solver();
+        }
+        amrex::Real elapsed = amrex::ParallelDescriptor::second() - t0;
+
+        amrex::Real rate = static_cast<amrex::Real>(ntot) * problem::nreps / elapsed;
+
+        std::cout << std::setw(24) << std::left << name
+                  << std::setw(16) << std::right << std::scientific << std::setprecision(4) << elapsed
+                  << std::setw(16) << rate << std::endl;
+
+        return rate;
+    }
+
+    amrex::Real
+    max_difference(const std::vector<RiemannState>& a, const std::vector<RiemannState>& b)
+    {
+        amrex::Real diff = 0.0_rt;
+        for (std::size_t m = 0; m < a.size(); ++m) {
+            diff = std::max(diff, std::abs(a[m].rho - b[m].rho) / std::abs(a[m].rho));
+            diff = std::max(diff, std::abs(a[m].p - b[m].p) / std::abs(a[m].p));
+            diff = std::max(diff, std::abs(a[m].rhoe - b[m].rhoe) / std::abs(a[m].rhoe));
+            diff = std::max(diff, std::abs(a[m].un - b[m].un));
+        }
+        return diff;
+    }
+
+}
+
+int main(int argc, char *argv[]) {
+
+    amrex::Initialize(argc, argv);
+
+    std::cout << "starting the Riemann solver benchmark..." << std::endl;
+
+    // initialize the Castro runtime parameters
+
+    amrex::ParmParse pp("castro");
+#include <castro_queries.H>
+
+    // initialize the external runtime parameters in C++
+
+    init_prob_parameters();
+
+    init_extern_parameters();
+
+    // now initialize the C++ Microphysics
+#ifdef REACTIONS
+    network_init();
+#endif
+
+    eos_init(castro::small_temp, castro::small_dens);
+
+    // create the random left and right states.  We use the EOS to get
+    // a thermodynamically consistent rho e and gamma_1.
+
+    const int ntot = problem::npts * problem::nbatch;
+
+    std::vector<RiemannState> ql(ntot);
+    std::vector<RiemannState> qr(ntot);
+    std::vector<RiemannAux> raux(ntot);
+
+    std::mt19937 gen(problem::seed);
+    std::uniform_real_distribution<amrex::Real> rho_dist(problem::rho_lo, problem::rho_hi);
+    std::uniform_real_distribution<amrex::Real> p_dist(problem::p_lo, problem::p_hi);
+    std::uniform_real_distribution<amrex::Real> u_dist(problem::u_lo, problem::u_hi);
+
+    auto fill_state = [&] (RiemannState& q) {
+
+        eos_t eos_state;
+        eos_state.rho = rho_dist(gen);
+        eos_state.p = p_dist(gen);
+        eos_state.T = 1.e4_rt;
+        for (int n = 0; n < NumSpec; ++n) {
+            eos_state.xn[n] = 0.0_rt;
+        }
+        eos_state.xn[0] = 1.0_rt;
+
+        eos(eos_input_rp, eos_state);
+
+        q.rho = eos_state.rho;
+        q.p = eos_state.p;
+        q.rhoe = eos_state.rho * eos_state.e;
+        q.gamc = eos_state.gam1;
+        q.un = u_dist(gen);
+        q.ut = u_dist(gen);
+        q.utt = u_dist(gen);
+
+        return std::sqrt(eos_state.gam1 * eos_state.p / eos_state.rho);
+    };
+
+    for (int m = 0; m < ntot; ++m) {
+        amrex::Real cl = fill_state(ql[m]);
+        amrex::Real cr = fill_state(qr[m]);
+
+        raux[m].csmall = amrex::max(riemann_constants::small,
+                                    riemann_constants::small * amrex::max(cl, cr));
+        raux[m].cavg = 0.5_rt * (cl + cr);
+        raux[m].bnd_fac = 1.0_rt;
+    }
+
+    std::vector<RiemannState> qint_scalar(ntot);
+    std::vector<RiemannState> qint_batch(ntot);
+
+    std::cout << "number of interfaces: " << ntot
+              << " (" << problem::nbatch << " batches of " << problem::npts << ")" << std::endl;
+    std::cout << "batch width: " << RiemannBatch::width << std::endl;
+    std::cout << std::endl;
+
+    std::cout << std::setw(24) << std::left << "solver"
+              << std::setw(16) << std::right << "time (s)"
+              << std::setw(16) << "interfaces / s" << std::endl;
+
+    // Colella-Glaz-Ferguson
+
+    amrex::Real us_scalar = time_solver("riemannus",
+        [&] () {
+            for (int m = 0; m < ntot; ++m) {
+                TwoShock::riemannus(ql[m], qr[m], raux[m], qint_scalar[m]);
+            }
+        }, ntot);
+
+    amrex::Real us_batch = time_solver("riemannus (batch)",
+        [&] () {
+            for (int b = 0; b < problem::nbatch; ++b) {
+                const int m = b * problem::npts;
+                RiemannBatch::riemannus(&ql[m], &qr[m], &raux[m], &qint_batch[m], problem::npts);
+            }
+        }, ntot);
+
+    amrex::Real us_diff = max_difference(qint_scalar, qint_batch);
+
+    // Colella-Glaz
+
+    amrex::Real cg_scalar = time_solver("riemanncg",
+        [&] () {
+            for (int m = 0; m < ntot; ++m) {
+                TwoShock::riemanncg(ql[m], qr[m], raux[m], qint_scalar[m]);
+            }
+        }, ntot);
+
+    amrex::Real cg_batch = time_solver("riemanncg (batch)",
+        [&] () {
+            for (int b = 0; b < problem::nbatch; ++b) {
+                const int m = b * problem::npts;
+                RiemannBatch::riemanncg(&ql[m], &qr[m], &raux[m], &qint_batch[m], problem::npts);
+            }
+        }, ntot);
+
+    amrex::Real cg_diff = max_difference(qint_scalar, qint_batch);
+
+    std::cout << std::endl;
+    std::cout << "riemannus: batch speedup = " << std::fixed << std::setprecision(2) << us_batch / us_scalar
+              << ", max difference = " << std::scientific << us_diff << std::endl;
+    std::cout << "riemanncg: batch speedup = " << std::fixed << std::setprecision(2) << cg_batch / cg_scalar
+              << ", max difference = " << std::scientific << cg_diff << std::endl;
+
+    amrex::Finalize();
+
+}
@@ -102,6 +102,29 @@ def read_diag_file(file_path, dedupe=True):
     return data
 
 
+def read_binary_diag_file(file_path, dedupe=True):
+    """Reads a binary Castro diagnostic file (*_diag.bin, written when
+    castro.binary_data_logs = 1) into a numpy structured array.
+
+    The file starts with a text header: the line "CASTRO_BINARY_LOG", the
+    number of columns, and one column name per line.  The rest of the file
+    is the rows of the log as native-endian doubles.
+    """
+    with open(file_path, "rb") as f:
+        magic = f.readline().decode().strip()
+        if magic != "CASTRO_BINARY_LOG":
+            raise ValueError("Not a Castro binary diagnostic file")
+        num_columns = int(f.readline())
+        names = [f.readline().decode().strip() for _ in range(num_columns)]
+        raw = np.fromfile(f, dtype=np.float64)
+    raw = raw[: (raw.size // num_columns) * num_columns].reshape(-1, num_columns)
+    data = np.rec.fromarrays(raw.T, names=names)
+    if dedupe:
+        _, rev_indices = np.unique(data["timestep"][::-1], return_index=True)
+        data = data[data.shape[0] - rev_indices - 1]
+    return data
+
+
 def deduplicate(data):
     """Deduplicate based on the timestep, keeping the only last occurrence."""
     # get the unique indices into the reversed timestep array, so we find the
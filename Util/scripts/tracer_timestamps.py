@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Read the binary tracer particle timestamp files (particles.timestamp_binary)
+
+Each rank writes its own file, <timestamp_dir>/Timestamp_bin_NNNNN.  A
+particle can move between ranks during a run, so its history is spread
+over several files; this script gathers the records and splits them into
+one history per particle, sorted in time.
+
+The files are only appended to, so after a restart the records written
+between the checkpoint and the end of the earlier run appear twice.
+Records with the same particle and time are merged, keeping the one
+read last.
+
+To use the reader in a standalone script, do
+`from tracer_timestamps import read_timestamp_dir`, or run this file to
+convert a timestamp directory:
+
+    tracer_timestamps.py particle_dir -o tracers.npz
+    tracer_timestamps.py particle_dir --txt histories/
+"""
+
+import argparse
+import struct
+from pathlib import Path
+
+import numpy as np
+
+""" Format notes
+files are written in Source/particles/CastroParticles.cpp
+(values are in the native byte order of the writer, which this reader assumes is little-endian)
+
+header (once per file):
+  char[8]  magic "CTRACER1"
+  int32    ndim
+  int32    nfields
+  nfields x (int32 state index, int32 name length, char[length] name)
+
+followed by any number of chunks:
+  int64    nrec
+  int64    id[nrec]
+  int32    cpu[nrec]
+  float64  time[nrec]
+  float64  pos[ndim][nrec]
+  float64  field[nfields][nrec]
+"""
+
+MAGIC = b"CTRACER1"
+
+
+def read_timestamp_file(filename):
+    """Read one binary timestamp file.
+
+    Returns a dict with the arrays "id", "cpu", "time", "pos" (shape
+    (nrec, ndim)) and "fields" (shape (nrec, nfields)), plus the list of
+    field names under "names".
+    """
+    data = Path(filename).read_bytes()
+
+    if data[:8] != MAGIC:
+        raise ValueError(f"{filename} is not a binary tracer timestamp file")
+
+    off = 8
+    ndim, nfields = struct.unpack_from("<ii", data, off)
+    off += 8
+
+    names = []
+    for _ in range(nfields):
+        _, length = struct.unpack_from("<ii", data, off)
+        off += 8
+        names.append(data[off:off + length].decode())
+        off += length
+
+    chunks = []
+    while off < len(data):
+        (nrec,) = struct.unpack_from("<q", data, off)
+        off += 8
+
+        def column(dtype, count=nrec):
+            nonlocal off
+            arr = np.frombuffer(data, dtype=dtype, count=count, offset=off)
+            off += arr.nbytes
+            return arr
+
+        ids = column("<i8")
+        cpu = column("<i4")
+        time = column("<f8")
+        pos = column("<f8", ndim * nrec).reshape(ndim, nrec)
+        fields = column("<f8", nfields * nrec).reshape(nfields, nrec)
+        chunks.append((ids, cpu, time, pos, fields))
+
+    if not chunks:
+        return {"id": np.empty(0, dtype=np.int64),
+                "cpu": np.empty(0, dtype=np.int32),
+                "time": np.empty(0),
+                "pos": np.empty((0, ndim)),
+                "fields": np.empty((0, nfields)),
+                "names": names}
+
+    return {"id": np.concatenate([c[0] for c in chunks]),
+            "cpu": np.concatenate([c[1] for c in chunks]),
+            "time": np.concatenate([c[2] for c in chunks]),
+            "pos": np.concatenate([c[3] for c in chunks], axis=1).T,
+            "fields": np.concatenate([c[4] for c in chunks], axis=1).T,
+            "names": names}
+
+
+def read_timestamp_dir(dirname):
+    """Read all of the binary timestamp files in a directory and return
+    a dict mapping (id, cpu) to that particle's history, sorted in time.
+
+    Each history is a dict with "time", "pos" and one array per field.
+    """
+    files = sorted(Path(dirname).glob("Timestamp_bin_*"))
+    if not files:
+        raise FileNotFoundError(f"no binary timestamp files in {dirname}")
+
+    recs = [read_timestamp_file(f) for f in files]
+
+    names = recs[0]["names"]
+    for f, r in zip(files, recs):
+        if r["names"] != names:
+            raise ValueError(f"{f} has different fields ({r['names']}) than {files[0]} ({names})")
+
+    ids = np.concatenate([r["id"] for r in recs])
+    cpu = np.concatenate([r["cpu"] for r in recs])
+    time = np.concatenate([r["time"] for r in recs])
+    pos = np.concatenate([r["pos"] for r in recs])
+    fields = np.concatenate([r["fields"] for r in recs])
+
+    # sort by particle and then by time (the sort is stable, so repeated
+    # records stay in the order they were read), and split at each new particle
+    order = np.lexsort((time, cpu, ids))
+    ids, cpu, time, pos, fields = ids[order], cpu[order], time[order], pos[order], fields[order]
+
+    # a restart writes the records after its checkpoint again, keep the last copy
+    keep = np.r_[(ids[1:] != ids[:-1]) | (cpu[1:] != cpu[:-1]) | (time[1:] != time[:-1]), True]
+    ids, cpu, time, pos, fields = ids[keep], cpu[keep], time[keep], pos[keep], fields[keep]
+
+    starts = np.flatnonzero(np.r_[True, (ids[1:] != ids[:-1]) | (cpu[1:] != cpu[:-1])])
+    ends = np.r_[starts[1:], len(ids)]
+
+    histories = {}
+    for s, e in zip(starts, ends):
+        h = {"time": time[s:e], "pos": pos[s:e]}
+        for n, name in enumerate(names):
+            h[name] = fields[s:e, n]
+        histories[(int(ids[s]), int(cpu[s]))] = h
+
+    return histories
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("timestamp_dir", help="directory given by particles.timestamp_dir")
+    parser.add_argument("-o", "--npz", help="write all of the histories to this .npz file")
+    parser.add_argument("--txt", help="write one text file per particle into this directory")
+    args = parser.parse_args()
+
+    histories = read_timestamp_dir(args.timestamp_dir)
+    print(f"read {len(histories)} particle histories")
+
+    if args.npz:
+        out = {}
+        for (pid, cpu), h in histories.items():
+            for key, val in h.items():
+                out[f"{pid}_{cpu}/{key}"] = val
+        np.savez(args.npz, **out)
+
+    if args.txt:
+        outdir = Path(args.txt)
+        outdir.mkdir(parents=True, exist_ok=True)
+        for (pid, cpu), h in histories.items():
+            names = [k for k in h if k not in ("time", "pos")]
+            ndim = h["pos"].shape[1]
+            cols = [h["time"]] + [h["pos"][:, d] for d in range(ndim)] + [h[n] for n in names]
+            header = " ".join(["time"] + ["xyz"[d] for d in range(ndim)] + names)
+            np.savetxt(outdir / f"particle_{pid}_{cpu}.txt", np.column_stack(cols), header=header)
+
+
+if __name__ == "__main__":
+    main()